@@ -0,0 +1,431 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file CooperativePathfinder.cpp
+ * @brief Implementation of the windowed cooperative A* pathfinder
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "CooperativePathfinder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define MAX_WINDOW 63          // The ring holds 64 time slices: the current step and a full window after it
+#define WAIT_MOVE 4            // Move of a state reached by waiting in place
+#define UNREACHED std::numeric_limits<std::uint32_t>::max()
+#define PAGE_SHIFT 6           // log2 of the side of a reverse search page, a square of 64x64 cells (16 KB)
+#define CLOSED_BIT 0x80000000u // Set in a reverse search entry once its steps to the goal are exact
+
+CooperativePathfinder::CooperativePathfinder(const Maze &maze, int window, int threadCount)
+    : m_maze(maze), m_window(window), m_num_threads((threadCount > 0) ? threadCount : omp_get_max_threads()), m_plan_count(0),
+      m_nodes_explored(0), m_heuristic_seconds(0.0), m_plan_seconds(0.0)
+{
+    if (window < 2 || window > MAX_WINDOW)
+    {
+        throw std::invalid_argument("Window must be between 2 and " + std::to_string(MAX_WINDOW) + " time steps");
+    }
+    // Two agents in different tiles of the same color are more than a tile apart, and each one only reaches a window away
+    m_tile_size = 2 * window + 1;
+    m_tile_rows = (maze.getHeight() + m_tile_size - 1) / m_tile_size;
+    m_tile_cols = (maze.getWidth() + m_tile_size - 1) / m_tile_size;
+    m_page_rows = (maze.getHeight() + (1 << PAGE_SHIFT) - 1) >> PAGE_SHIFT;
+    m_page_cols = (maze.getWidth() + (1 << PAGE_SHIFT) - 1) >> PAGE_SHIFT;
+    m_searches.resize(m_num_threads);
+}
+
+std::size_t CooperativePathfinder::getMemoryUsage() const
+{
+    std::size_t bytes = m_reserved.capacity() * sizeof(std::uint64_t) + m_tile_agents.capacity() * sizeof(int) +
+                        m_tile_start.capacity() * sizeof(int);
+    for (const Agent &agent : m_agents)
+    {
+        bytes += agent.plan.capacity() * sizeof(int) + agent.pages.capacity() * sizeof(agent.pages[0]) +
+                 agent.open.capacity() * sizeof(agent.open[0]);
+        for (const std::unique_ptr<std::uint32_t[]> &page : agent.pages)
+        {
+            bytes += page ? (sizeof(std::uint32_t) << (2 * PAGE_SHIFT)) : 0;
+        }
+    }
+    for (const SpaceTimeSearch &search : m_searches)
+    {
+        bytes += search.stamp.capacity() * sizeof(std::uint32_t) + search.move.capacity() +
+                 search.open.capacity() * sizeof(search.open[0]);
+    }
+    return bytes;
+}
+
+void CooperativePathfinder::reservePlanStep(const Agent &agent, int time, bool hold)
+{
+    const int step = time - agent.planStart;
+    const int cell = agent.plan[step];
+    const int left = (step > 0 && agent.plan[step - 1] != cell) ? agent.plan[step - 1] : -1;
+    if (hold)
+    {
+        reserve(cell, time);
+        if (left >= 0)
+        {
+            reserve(left, time);
+        }
+    }
+    else
+    {
+        release(cell, time);
+        if (left >= 0)
+        {
+            release(left, time);
+        }
+    }
+}
+
+void CooperativePathfinder::startReverseSearch(Agent &agent) const
+{
+    agent.startRow = m_maze.rowOf(agent.cell);
+    agent.startCol = m_maze.colOf(agent.cell);
+    agent.pages.clear();
+    agent.pages.resize(static_cast<std::size_t>(m_page_rows) * m_page_cols);
+    agent.open.clear();
+    reverseEntry(agent, agent.goal) = 1;
+    agent.open.emplace_back(0, agent.goal);
+}
+
+std::uint32_t &CooperativePathfinder::reverseEntry(Agent &agent, int cell) const
+{
+    const int row = m_maze.rowOf(cell);
+    const int col = m_maze.colOf(cell);
+    std::unique_ptr<std::uint32_t[]> &page = agent.pages[(row >> PAGE_SHIFT) * m_page_cols + (col >> PAGE_SHIFT)];
+    if (!page)
+    {
+        page = std::make_unique<std::uint32_t[]>(std::size_t(1) << (2 * PAGE_SHIFT));
+    }
+    return page[((row & ((1 << PAGE_SHIFT) - 1)) << PAGE_SHIFT) | (col & ((1 << PAGE_SHIFT) - 1))];
+}
+
+std::uint32_t CooperativePathfinder::distanceToGoal(Agent &agent, int cell) const
+{
+    const std::uint32_t known = reverseEntry(agent, cell);
+    if (known & CLOSED_BIT)
+    {
+        return (known & ~CLOSED_BIT) - 1;
+    }
+
+    // Resume the search; the Manhattan distance to the start is consistent, so a cell's steps are exact once it is closed
+    // f score in the high bits and the steps in the low ones inverted, so ties go to the cell farther from the goal
+    auto key = [this, &agent](int index, std::uint32_t steps) {
+        const std::uint32_t f = steps + std::abs(m_maze.rowOf(index) - agent.startRow) + std::abs(m_maze.colOf(index) - agent.startCol);
+        return (static_cast<std::uint64_t>(f) << 32) | (UNREACHED - steps);
+    };
+    auto greater = std::greater<std::pair<std::uint64_t, int>>();
+    const int stride = m_maze.getStride();
+    while (!agent.open.empty())
+    {
+        std::pop_heap(agent.open.begin(), agent.open.end(), greater);
+        const int current = agent.open.back().second;
+        agent.open.pop_back();
+        std::uint32_t &value = reverseEntry(agent, current);
+        if (value & CLOSED_BIT)
+        {
+            continue; // Reached again with fewer steps and closed already
+        }
+        value |= CLOSED_BIT;
+        const std::uint32_t steps = (value & ~CLOSED_BIT) - 1;
+        for (int neighbor : {current - stride, current + stride, current - 1, current + 1})
+        {
+            if (!m_maze.isPassable(neighbor))
+            {
+                continue;
+            }
+            std::uint32_t &next = reverseEntry(agent, neighbor);
+            if (next == 0 || (!(next & CLOSED_BIT) && next > steps + 2))
+            {
+                next = steps + 2;
+                agent.open.emplace_back(key(neighbor, steps + 1), neighbor);
+                std::push_heap(agent.open.begin(), agent.open.end(), greater);
+            }
+        }
+        if (current == cell)
+        {
+            return steps;
+        }
+    }
+    return UNREACHED;
+}
+
+void CooperativePathfinder::assignTiles()
+{
+    const int tileCount = m_tile_rows * m_tile_cols;
+    auto tileOf = [this](int cell) { return (m_maze.rowOf(cell) / m_tile_size) * m_tile_cols + m_maze.colOf(cell) / m_tile_size; };
+
+    // Counting sort keeps the agents of a tile in priority order, those that have not arrived before those that have
+    m_tile_start.assign(tileCount + 1, 0);
+    for (const Agent &agent : m_agents)
+    {
+        ++m_tile_start[tileOf(agent.cell) + 1];
+    }
+    for (int tile = 0; tile < tileCount; ++tile)
+    {
+        m_tile_start[tile + 1] += m_tile_start[tile];
+    }
+    m_tile_agents.resize(m_agents.size());
+    std::vector<int> next(m_tile_start.begin(), m_tile_start.end() - 1);
+    for (int arrived = 0; arrived < 2; ++arrived)
+    {
+        for (std::size_t i = 0; i < m_agents.size(); ++i)
+        {
+            if ((m_agents[i].cell == m_agents[i].goal) == (arrived == 1))
+            {
+                m_tile_agents[next[tileOf(m_agents[i].cell)]++] = static_cast<int>(i);
+            }
+        }
+    }
+    for (std::vector<int> &tiles : m_color_tiles)
+    {
+        tiles.clear();
+    }
+    for (int tile = 0; tile < tileCount; ++tile)
+    {
+        if (m_tile_start[tile + 1] > m_tile_start[tile])
+        {
+            m_color_tiles[((tile / m_tile_cols) & 1) * 2 + ((tile % m_tile_cols) & 1)].push_back(tile);
+        }
+    }
+}
+
+void CooperativePathfinder::extendPlan(Agent &agent, int time)
+{
+    for (int t = time; t <= agent.planStart + m_window; ++t)
+    {
+        reservePlanStep(agent, t, false);
+    }
+    agent.plan.erase(agent.plan.begin(), agent.plan.begin() + (time - agent.planStart));
+    agent.plan.resize(m_window + 1, agent.plan.back());
+    agent.planStart = time;
+    for (int t = time; t <= time + m_window; ++t)
+    {
+        reservePlanStep(agent, t, true);
+    }
+}
+
+void CooperativePathfinder::planAgent(Agent &agent, int time, SpaceTimeSearch &search)
+{
+    // Free what the extended old plan holds; the search can always find it again, nothing else may have reserved it
+    for (int t = time; t <= time + m_window; ++t)
+    {
+        reservePlanStep(agent, t, false);
+    }
+
+    // A state is a cell of the square of side 2 * window + 1 around the agent at one step of the window
+    const int side = 2 * m_window + 1;
+    const int area = side * side;
+    const std::size_t states = static_cast<std::size_t>(area) * (m_window + 1);
+    if (search.stamp.size() != states)
+    {
+        search.stamp.assign(states, 0);
+        search.move.resize(states);
+        search.search = 0;
+    }
+    if (++search.search == 0)
+    {
+        std::fill(search.stamp.begin(), search.stamp.end(), 0);
+        search.search = 1;
+    }
+    const int stride = m_maze.getStride();
+    const int center = m_window * side + m_window;
+    const int cellOffsets[WAIT_MOVE + 1] = {-stride, stride, -1, 1, 0};
+    const int localOffsets[WAIT_MOVE + 1] = {-side, side, -1, 1, 0};
+
+    // f score in the high bits and the steps left in the low ones, so ties go to the deeper state
+    auto key = [this](std::uint32_t f, int depth) {
+        return (static_cast<std::uint64_t>(f) << 8) | static_cast<std::uint64_t>(m_window - depth);
+    };
+    auto greater = std::greater<std::pair<std::uint64_t, int>>();
+    search.open.clear();
+    search.stamp[center] = search.search;
+    search.open.emplace_back(key(distanceToGoal(agent, agent.cell), 0), center);
+
+    int terminal = -1;
+    while (!search.open.empty())
+    {
+        std::pop_heap(search.open.begin(), search.open.end(), greater);
+        const int state = search.open.back().second;
+        search.open.pop_back();
+        ++search.nodesExplored;
+        const int depth = state / area;
+        if (depth == m_window)
+        {
+            terminal = state;
+            break;
+        }
+        const int local = state % area;
+        const int cell = agent.cell + (local / side - m_window) * stride + (local % side - m_window);
+        const int arrival = time + depth + 1;
+        if (isReserved(cell, arrival))
+        {
+            // Someone enters this cell on the next step: the agent can neither wait nor leave it, it would be followed or swapped
+            continue;
+        }
+        for (int move = 0; move <= WAIT_MOVE; ++move)
+        {
+            const int next = cell + cellOffsets[move];
+            const int nextState = state + area + localOffsets[move];
+            if (search.stamp[nextState] == search.search || !m_maze.isPassable(next) || isReserved(next, arrival))
+            {
+                continue;
+            }
+            const std::uint32_t distance = distanceToGoal(agent, next);
+            if (distance == UNREACHED)
+            {
+                continue;
+            }
+            search.stamp[nextState] = search.search;
+            search.move[nextState] = static_cast<std::uint8_t>(move);
+            search.open.emplace_back(key(depth + 1 + distance, depth + 1), nextState);
+            std::push_heap(search.open.begin(), search.open.end(), greater);
+        }
+    }
+
+    // Walk back from the end of the window; without an end the old plan is kept, though it is always found
+    for (int state = terminal, depth = m_window; terminal >= 0 && depth >= 0; --depth)
+    {
+        const int local = state % area;
+        agent.plan[depth] = agent.cell + (local / side - m_window) * stride + (local % side - m_window);
+        if (depth > 0)
+        {
+            state -= area + localOffsets[search.move[state]];
+        }
+    }
+    for (int t = time; t <= time + m_window; ++t)
+    {
+        reservePlanStep(agent, t, true);
+    }
+}
+
+bool CooperativePathfinder::route(const std::vector<PathQuery> &agents, std::vector<std::vector<Position>> &paths, int maxSteps)
+{
+    // Starts and goals must be open and distinct, or two agents would share a cell from the first or up to the last step
+    std::vector<std::uint8_t> used(m_maze.getCellCount(), 0);
+    m_agents.resize(agents.size());
+    for (std::size_t i = 0; i < agents.size(); ++i)
+    {
+        const PathQuery &query = agents[i];
+        if (!m_maze.isInBounds(query.start.row, query.start.col) || !m_maze.isInBounds(query.goal.row, query.goal.col))
+        {
+            throw std::invalid_argument("Agent " + std::to_string(i) + " starts or ends outside the maze");
+        }
+        Agent &agent = m_agents[i];
+        agent.cell = m_maze.cellIndex(query.start.row, query.start.col);
+        agent.goal = m_maze.cellIndex(query.goal.row, query.goal.col);
+        if (!m_maze.isPassable(agent.cell) || !m_maze.isPassable(agent.goal))
+        {
+            throw std::invalid_argument("Agent " + std::to_string(i) + " starts or ends on a wall");
+        }
+        if ((used[agent.cell] & 1) || (used[agent.goal] & 2))
+        {
+            throw std::invalid_argument("Agent " + std::to_string(i) + " shares its start or goal with another agent");
+        }
+        used[agent.cell] |= 1;
+        used[agent.goal] |= 2;
+    }
+
+    // The distances to the goals do not depend on the other agents, so every agent's reverse search runs on its own thread
+    // until it reaches the start, which also tells whether the goal can be reached
+    auto startTime = std::chrono::high_resolution_clock::now();
+    const int agentCount = static_cast<int>(m_agents.size());
+    std::vector<std::uint32_t> startDistance(agentCount);
+#pragma omp parallel for schedule(dynamic, 1) num_threads(m_num_threads)
+    for (int i = 0; i < agentCount; ++i)
+    {
+        startReverseSearch(m_agents[i]);
+        startDistance[i] = distanceToGoal(m_agents[i], m_agents[i].cell);
+    }
+    m_heuristic_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    for (int i = 0; i < agentCount; ++i)
+    {
+        if (startDistance[i] == UNREACHED)
+        {
+            throw std::invalid_argument("Agent " + std::to_string(i) + " cannot reach its goal");
+        }
+    }
+
+    // Until it first plans, every agent holds its start for a whole window
+    const int interval = m_window / 2;
+    m_reserved.assign(m_maze.getCellCount(), 0);
+    paths.assign(agents.size(), {});
+    for (int i = 0; i < agentCount; ++i)
+    {
+        Agent &agent = m_agents[i];
+        agent.planStart = 0;
+        agent.plan.assign(m_window + 1, agent.cell);
+        for (int t = 0; t <= m_window; ++t)
+        {
+            reservePlanStep(agent, t, true);
+        }
+        paths[i].push_back(agents[i].start);
+    }
+    m_plan_count = 0;
+    m_nodes_explored = 0;
+    m_plan_seconds = 0.0;
+    for (SpaceTimeSearch &search : m_searches)
+    {
+        search.nodesExplored = 0;
+    }
+
+    int time = 0;
+    auto arrived = [this]() {
+        return std::all_of(m_agents.begin(), m_agents.end(), [](const Agent &agent) { return agent.cell == agent.goal; });
+    };
+    while (time < maxSteps && !arrived())
+    {
+        if (time % interval == 0)
+        {
+            // Agents still on their way plan first within a tile, and the colors take turns going first
+            startTime = std::chrono::high_resolution_clock::now();
+            for (Agent &agent : m_agents)
+            {
+                extendPlan(agent, time);
+            }
+            assignTiles();
+            for (int color = 0; color < 4; ++color)
+            {
+                const std::vector<int> &tiles = m_color_tiles[(color + time / interval) % 4];
+                const int tileCount = static_cast<int>(tiles.size());
+#pragma omp parallel for schedule(dynamic, 1) num_threads(m_num_threads)
+                for (int i = 0; i < tileCount; ++i)
+                {
+                    SpaceTimeSearch &search = m_searches[omp_get_thread_num()];
+                    const int tile = tiles[i];
+                    for (int k = m_tile_start[tile]; k < m_tile_start[tile + 1]; ++k)
+                    {
+                        planAgent(m_agents[m_tile_agents[k]], time, search);
+                    }
+                }
+            }
+            m_plan_count += agentCount;
+            m_plan_seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+        }
+
+        // Every agent takes the next step of its plan, then the time slice that passed is cleared for reuse
+        for (int i = 0; i < agentCount; ++i)
+        {
+            Agent &agent = m_agents[i];
+            agent.cell = agent.plan[time + 1 - agent.planStart];
+            paths[i].push_back({m_maze.rowOf(agent.cell), m_maze.colOf(agent.cell)});
+            reservePlanStep(agent, time, false);
+        }
+        ++time;
+    }
+    for (const SpaceTimeSearch &search : m_searches)
+    {
+        m_nodes_explored += search.nodesExplored;
+    }
+    return arrived();
+}
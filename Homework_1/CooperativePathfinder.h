@@ -0,0 +1,218 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file CooperativePathfinder.h
+ * @brief Many agents routed through one maze at the same time without colliding (windowed cooperative A*)
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Every agent plans in space and time: one step of its plan moves to a neighboring cell or
+ * waits in place, and costs 1. The cells each plan occupies at each time step are written to
+ * a reservation table that the agents planning after it avoid. A plan looks only a window of
+ * steps ahead; the rest of the way is estimated with the true distance to the goal in the
+ * maze without agents. Each agent finds it with a reverse A* search from its goal toward its
+ * start that is resumed whenever a plan asks for a cell it has not closed yet (resumable
+ * reverse A*, RRA*). The distances are kept in pages of cells allocated as the search reaches
+ * them, so an agent holds memory for the part of the maze its search explored, not for the
+ * whole grid. Every half window all agents plan again from where they stand, so the
+ * reservations only ever cover the next window of time steps.
+ *
+ * The table is a ring of 64 time slices with one bit per slice for every cell, so reserving,
+ * checking and releasing a cell are bit operations on one word and a slice is reused once
+ * its time step has passed. No hashing is needed.
+ *
+ * An agent's plan can only touch cells within a window of steps of where it stands. Agents
+ * standing farther than two windows apart cannot see each other's reservations, so the
+ * grid is cut into tiles two windows wide, colored like a checkerboard with four colors, and
+ * all tiles of one color are planned in parallel with OpenMP. The agents of one tile plan in
+ * order, and the colors are planned one after another.
+ */
+
+#ifndef HOMEWORK_1_COOPERATIVEPATHFINDER_H_
+#define HOMEWORK_1_COOPERATIVEPATHFINDER_H_
+
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include "PathQueryEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CooperativePathfinder
+ * @brief Windowed cooperative A* over a space-time reservation table
+ *
+ * The pathfinder reads the maze in route(), so walls may change between calls but not
+ * during one. An agent that reached its goal stays there, stepping aside only when an agent
+ * planned before it needs to pass. Agents never collide, but in narrow corridors they can
+ * block each other for good; route() then stops after maxSteps.
+ */
+class CooperativePathfinder
+{
+  public:
+    /**
+     * @brief Create a pathfinder for a maze
+     * @param maze The maze the agents move through
+     * @param window Time steps each plan looks ahead, between 2 and 63 so the current step and a window fit in the ring
+     * @param threadCount Number of OpenMP threads, 0 to use omp_get_max_threads()
+     * @throws std::invalid_argument if window is outside [2, 63]
+     */
+    explicit CooperativePathfinder(const Maze &maze, int window = 16, int threadCount = 0);
+
+    /**
+     * @brief Move the agents until all of them stand on their goals
+     * @param agents Start and goal of every agent, in priority order; starts and goals must be distinct open cells
+     * @param paths Receives the cell of every agent at every time step, from its start to the last step
+     * @param maxSteps Time steps after which the agents that did not arrive are left where they are
+     * @return True if every agent stands on its goal at the last step
+     * @throws std::invalid_argument if a start or goal is a wall, two agents share a start or a goal, or a goal cannot be reached
+     */
+    bool route(const std::vector<PathQuery> &agents, std::vector<std::vector<Position>> &paths, int maxSteps);
+
+    /**
+     * @brief Get the number of threads the agents are planned on
+     */
+    int getNumThreads() const
+    {
+        return m_num_threads;
+    }
+    /**
+     * @brief Get the number of windowed plans the last call made, one per agent every half window
+     */
+    long long getPlanCount() const
+    {
+        return m_plan_count;
+    }
+    /**
+     * @brief Get the number of space-time states expanded by the last call
+     */
+    long long getNodesExplored() const
+    {
+        return m_nodes_explored;
+    }
+    /**
+     * @brief Get the seconds the last call spent in the reverse searches from the goals up to the starts
+     * Resuming them for the cells the plans ask for later counts as planning.
+     */
+    double getHeuristicSeconds() const
+    {
+        return m_heuristic_seconds;
+    }
+    /**
+     * @brief Get the seconds the last call spent planning, the distances to the goals excluded
+     */
+    double getPlanSeconds() const
+    {
+        return m_plan_seconds;
+    }
+    /**
+     * @brief Get the bytes held by the reservation table, the reverse searches and the search buffers
+     */
+    std::size_t getMemoryUsage() const;
+
+  private:
+    // Buffers of one thread's space-time search, indexed by state: the cell relative to the agent in a square of side
+    // 2 * window + 1, times window + 1 time steps
+    struct SpaceTimeSearch
+    {
+        std::vector<std::uint32_t> stamp;                // Search that last reached each state
+        std::vector<std::uint8_t> move;                  // Move into each state: 0 to 3 like MazeSolver's directions, 4 to wait
+        std::vector<std::pair<std::uint64_t, int>> open; // Heap of (f score and depth packed, state)
+        std::uint32_t search = 0;                        // Number of the current search
+        long long nodesExplored = 0;
+    };
+
+    // Agent being routed
+    struct Agent
+    {
+        int cell;              // Flat grid index of the cell it stands on
+        int goal;              // Flat grid index of its goal
+        int planStart;         // Time step plan[0] belongs to
+        std::vector<int> plan; // Flat grid index at each step of the window, window + 1 entries
+
+        // Reverse A* from the goal, heading for the start the agent had when route() was called. Per square page of cells,
+        // pages holds 0 for a cell not seen yet and its steps to the goal plus 1 otherwise, with CLOSED_BIT once they are
+        // exact; a page stays null until the search reaches it.
+        int startRow;
+        int startCol;
+        std::vector<std::unique_ptr<std::uint32_t[]>> pages;
+        std::vector<std::pair<std::uint64_t, int>> open; // Heap of (f score and steps packed, cell)
+    };
+
+    const Maze &m_maze;
+    int m_window;
+    int m_num_threads;
+    int m_tile_size; // Side of a tile, two windows and a margin
+    int m_tile_rows;
+    int m_tile_cols;
+    int m_page_rows; // Pages of the reverse searches down the maze, each a square of cells
+    int m_page_cols;
+    std::vector<std::uint64_t> m_reserved;   // Per cell: bit t % 64 is set while some agent holds it at time step t
+    std::vector<Agent> m_agents;
+    std::vector<SpaceTimeSearch> m_searches; // One per thread, kept between calls
+    std::vector<int> m_tile_start;           // Agents of tile t are m_tile_agents[m_tile_start[t]] up to m_tile_start[t + 1]
+    std::vector<int> m_tile_agents;          // Agents sorted by tile, in priority order inside a tile
+    std::vector<int> m_color_tiles[4];       // Non-empty tiles of each checkerboard color
+    long long m_plan_count;
+    long long m_nodes_explored;
+    double m_heuristic_seconds;
+    double m_plan_seconds;
+
+    /**
+     * @brief Set, clear or test the reservation of a cell at a time step
+     */
+    bool isReserved(int cell, int time) const
+    {
+        return (m_reserved[cell] >> (time & 63)) & 1;
+    }
+    void reserve(int cell, int time)
+    {
+        m_reserved[cell] |= std::uint64_t(1) << (time & 63);
+    }
+    void release(int cell, int time)
+    {
+        m_reserved[cell] &= ~(std::uint64_t(1) << (time & 63));
+    }
+    /**
+     * @brief Apply reserve or release to what an agent's plan holds at a time step
+     * Leaving a cell holds it for one more step, so no agent can swap places with it or move in right behind it.
+     */
+    void reservePlanStep(const Agent &agent, int time, bool hold);
+    /**
+     * @brief Start an agent's reverse search from its goal toward the cell it stands on
+     */
+    void startReverseSearch(Agent &agent) const;
+    /**
+     * @brief Get the entry of a cell in an agent's reverse search, allocating its page if the search never reached it
+     */
+    std::uint32_t &reverseEntry(Agent &agent, int cell) const;
+    /**
+     * @brief Get the steps from a cell to an agent's goal, resuming its reverse search until the cell is closed
+     * @param agent The agent
+     * @param cell Flat grid index of an open cell
+     * @return Steps to the goal, UNREACHED if the cell is not connected to it
+     */
+    std::uint32_t distanceToGoal(Agent &agent, int cell) const;
+    /**
+     * @brief Sort the agents into tiles by the cell they stand on and list the non-empty tiles of each color
+     */
+    void assignTiles();
+    /**
+     * @brief Move the start of an agent's plan to a time step and wait at its last cell to fill the window again
+     * Nobody has reserved the steps after the old window yet, so the agent can always follow the extended plan.
+     */
+    void extendPlan(Agent &agent, int time);
+    /**
+     * @brief Replace an agent's plan by a new one for the window starting at a time step and reserve it
+     * @param agent The agent, whose plan was extended to the window; it is released first
+     * @param time Current time step
+     * @param search Buffers of the calling thread
+     */
+    void planAgent(Agent &agent, int time, SpaceTimeSearch &search);
+};
+
+#endif // HOMEWORK_1_COOPERATIVEPATHFINDER_H_
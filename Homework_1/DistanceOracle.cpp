@@ -0,0 +1,342 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file DistanceOracle.cpp
+ * @brief Implementation of the junction tree distance oracle
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "DistanceOracle.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#define LOOP_ERROR "The maze has loops, the distance oracle needs a perfect maze"
+
+DistanceOracle::DistanceOracle(const Maze &maze)
+    : m_maze(maze), m_neighbor_offset{-maze.getStride(), maze.getStride(), -1, 1}
+{
+    contractCorridors();
+    buildHeavyPaths();
+}
+
+int DistanceOracle::degree(int index) const
+{
+    int open = 0;
+    for (int offset : m_neighbor_offset)
+    {
+        open += m_maze.isPassable(index + offset) ? 1 : 0;
+    }
+    return open;
+}
+
+void DistanceOracle::contractCorridors()
+{
+    const int cellCount = m_maze.getCellCount();
+    m_cell_edge.assign(cellCount, -1);
+    m_cell_offset.assign(cellCount, 0);
+
+    auto addJunction = [this](int index, int parent, int depth, int tree) {
+        m_cell_edge[index] = static_cast<int>(m_junction_cell.size());
+        m_junction_cell.push_back(index);
+        m_parent.push_back(parent);
+        m_depth.push_back(depth);
+        m_tree.push_back(tree);
+    };
+
+    // Junctions get their ids in the order they are found, so expanding them in id order is a breadth-first walk of
+    // the tree and every parent has a smaller id than its children
+    std::vector<int> corridor;
+    int trees = 0;
+    for (int root = 0; root < cellCount; ++root)
+    {
+        if (!m_maze.isPassable(root) || m_cell_edge[root] >= 0 || degree(root) == 2)
+        {
+            continue;
+        }
+        addJunction(root, -1, 0, trees);
+        for (int junction = m_cell_edge[root]; junction < getJunctionCount(); ++junction)
+        {
+            const int junctionCell = m_junction_cell[junction];
+            const int parentSide = (m_parent[junction] >= 0) ? towardRoot(junctionCell) : -1;
+            for (int offset : m_neighbor_offset)
+            {
+                int current = junctionCell + offset;
+                if (!m_maze.isPassable(current) || current == parentSide)
+                {
+                    continue;
+                }
+
+                // Follow the corridor to the junction at its other end
+                corridor.clear();
+                int previous = junctionCell;
+                while (degree(current) == 2 && m_cell_edge[current] < 0)
+                {
+                    corridor.push_back(current);
+                    int next = current;
+                    for (int step : m_neighbor_offset)
+                    {
+                        if (current + step != previous && m_maze.isPassable(current + step))
+                        {
+                            next = current + step;
+                            break;
+                        }
+                    }
+                    previous = current;
+                    current = next;
+                }
+
+                // In a tree every cell is reached exactly once
+                if (m_cell_edge[current] >= 0)
+                {
+                    throw std::invalid_argument(LOOP_ERROR);
+                }
+                addJunction(current, junction, m_depth[junction] + static_cast<int>(corridor.size()) + 1, trees);
+                for (std::size_t i = 0; i < corridor.size(); ++i)
+                {
+                    m_cell_edge[corridor[i]] = m_cell_edge[current];
+                    m_cell_offset[corridor[i]] = static_cast<int>(i) + 1;
+                }
+            }
+        }
+        ++trees;
+    }
+
+    // A ring of corridor cells has no junction to be found from
+    for (int index = 0; index < cellCount; ++index)
+    {
+        if (m_maze.isPassable(index) && m_cell_edge[index] < 0)
+        {
+            throw std::invalid_argument(LOOP_ERROR);
+        }
+    }
+}
+
+void DistanceOracle::buildHeavyPaths()
+{
+    const int junctionCount = getJunctionCount();
+
+    // Children come after their parents, so one backward pass adds up the subtree sizes
+    m_subtree_size.assign(junctionCount, 1);
+    std::vector<int> heavy(junctionCount, -1);
+    for (int junction = junctionCount - 1; junction >= 0; --junction)
+    {
+        const int parent = m_parent[junction];
+        if (parent >= 0)
+        {
+            m_subtree_size[parent] += m_subtree_size[junction];
+        }
+    }
+    for (int junction = 0; junction < junctionCount; ++junction)
+    {
+        const int parent = m_parent[junction];
+        if (parent >= 0 && (heavy[parent] < 0 || m_subtree_size[junction] > m_subtree_size[heavy[parent]]))
+        {
+            heavy[parent] = junction;
+        }
+    }
+
+    // A heavy child continues the heavy path of its parent, any other junction starts a new one
+    m_head.resize(junctionCount);
+    for (int junction = 0; junction < junctionCount; ++junction)
+    {
+        const int parent = m_parent[junction];
+        m_head[junction] = (parent >= 0 && heavy[parent] == junction) ? m_head[parent] : junction;
+    }
+
+    // Children lists in one array, then a depth-first walk numbers every subtree as one contiguous range
+    std::vector<int> childStart(junctionCount + 1, 0);
+    for (int junction = 0; junction < junctionCount; ++junction)
+    {
+        if (m_parent[junction] >= 0)
+        {
+            ++childStart[m_parent[junction] + 1];
+        }
+    }
+    for (int junction = 0; junction < junctionCount; ++junction)
+    {
+        childStart[junction + 1] += childStart[junction];
+    }
+    std::vector<int> children(childStart[junctionCount]);
+    std::vector<int> filled(childStart.begin(), childStart.end() - 1);
+    for (int junction = 0; junction < junctionCount; ++junction)
+    {
+        if (m_parent[junction] >= 0)
+        {
+            children[filled[m_parent[junction]]++] = junction;
+        }
+    }
+
+    m_preorder.resize(junctionCount);
+    std::vector<int> stack;
+    int position = 0;
+    for (int root = 0; root < junctionCount; ++root)
+    {
+        if (m_parent[root] >= 0)
+        {
+            continue;
+        }
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            const int junction = stack.back();
+            stack.pop_back();
+            m_preorder[junction] = position++;
+            stack.insert(stack.end(), children.begin() + childStart[junction], children.begin() + childStart[junction + 1]);
+        }
+    }
+}
+
+int DistanceOracle::lowestCommonAncestor(int u, int v) const
+{
+    // Climb from whichever heavy path starts deeper until both junctions are on the same one
+    while (m_head[u] != m_head[v])
+    {
+        if (m_depth[m_head[u]] < m_depth[m_head[v]])
+        {
+            std::swap(u, v);
+        }
+        u = m_parent[m_head[u]];
+    }
+    return (m_depth[u] < m_depth[v]) ? u : v;
+}
+
+int DistanceOracle::exitJunction(int index, int other, int &steps) const
+{
+    const int edge = m_cell_edge[index];
+    const int offset = m_cell_offset[index];
+    if (offset == 0)
+    {
+        steps = 0;
+        return edge;
+    }
+
+    // Downward if the other cell hangs below the child junction of the edge, upward otherwise
+    if (inSubtree(m_cell_edge[other], edge))
+    {
+        steps = m_depth[edge] - m_depth[m_parent[edge]] - offset;
+        return edge;
+    }
+    steps = offset;
+    return m_parent[edge];
+}
+
+int DistanceOracle::towardRoot(int index) const
+{
+    // A junction continues on the edge to its parent, a corridor cell moves one step closer to the parent junction
+    const int edge = m_cell_edge[index];
+    const int offset = m_cell_offset[index];
+    const int parent = m_parent[edge];
+    const int target = ((offset == 0) ? m_depth[edge] - m_depth[parent] : offset) - 1;
+    if (target == 0)
+    {
+        return m_junction_cell[parent];
+    }
+    for (int step : m_neighbor_offset)
+    {
+        if (m_cell_edge[index + step] == edge && m_cell_offset[index + step] == target)
+        {
+            return index + step;
+        }
+    }
+    return -1; // Not reached: every corridor offset exists
+}
+
+int DistanceOracle::towardChild(int index) const
+{
+    const int edge = m_cell_edge[index];
+    const int target = m_cell_offset[index] + 1;
+    if (target == m_depth[edge] - m_depth[m_parent[edge]])
+    {
+        return m_junction_cell[edge];
+    }
+    for (int step : m_neighbor_offset)
+    {
+        if (m_cell_edge[index + step] == edge && m_cell_offset[index + step] == target)
+        {
+            return index + step;
+        }
+    }
+    return -1; // Not reached: every corridor offset exists
+}
+
+int DistanceOracle::distance(Position from, Position to) const
+{
+    if (!m_maze.isInBounds(from.row, from.col) || !m_maze.isInBounds(to.row, to.col))
+    {
+        return -1;
+    }
+    const int a = m_maze.cellIndex(from.row, from.col);
+    const int b = m_maze.cellIndex(to.row, to.col);
+    if (m_cell_edge[a] < 0 || m_cell_edge[b] < 0 || m_tree[m_cell_edge[a]] != m_tree[m_cell_edge[b]])
+    {
+        return -1;
+    }
+
+    // Two cells of the same corridor are joined by the corridor itself
+    if (m_cell_edge[a] == m_cell_edge[b] && m_cell_offset[a] > 0 && m_cell_offset[b] > 0)
+    {
+        return std::abs(m_cell_offset[a] - m_cell_offset[b]);
+    }
+
+    int stepsA, stepsB;
+    const int exitA = exitJunction(a, b, stepsA);
+    const int exitB = exitJunction(b, a, stepsB);
+    const int ancestor = lowestCommonAncestor(exitA, exitB);
+    return stepsA + stepsB + m_depth[exitA] + m_depth[exitB] - (2 * m_depth[ancestor]);
+}
+
+bool DistanceOracle::findPath(Position from, Position to, std::vector<Position> &path) const
+{
+    path.clear();
+    if (distance(from, to) < 0)
+    {
+        return false;
+    }
+    const int a = m_maze.cellIndex(from.row, from.col);
+    const int b = m_maze.cellIndex(to.row, to.col);
+    auto append = [this, &path](int index) { path.push_back({m_maze.rowOf(index), m_maze.colOf(index)}); };
+
+    append(a);
+    if (m_cell_edge[a] == m_cell_edge[b] && m_cell_offset[a] > 0 && m_cell_offset[b] > 0)
+    {
+        for (int index = a; index != b;)
+        {
+            index = (m_cell_offset[b] < m_cell_offset[index]) ? towardRoot(index) : towardChild(index);
+            append(index);
+        }
+        return true;
+    }
+
+    // Walk each cell to the junction where it leaves its edge, then up to the common ancestor
+    int stepsA, stepsB;
+    const int exitA = exitJunction(a, b, stepsA);
+    const int exitB = exitJunction(b, a, stepsB);
+    const int ancestorCell = m_junction_cell[lowestCommonAncestor(exitA, exitB)];
+    auto climb = [&](int index, int exit) {
+        const bool down = m_cell_offset[index] > 0 && exit == m_cell_edge[index];
+        while (index != m_junction_cell[exit])
+        {
+            index = down ? towardChild(index) : towardRoot(index);
+            append(index);
+        }
+        while (index != ancestorCell)
+        {
+            index = towardRoot(index);
+            append(index);
+        }
+    };
+    climb(a, exitA);
+
+    // The half from the other cell is walked the same way and reversed, leaving out the common ancestor
+    const std::size_t middle = path.size();
+    append(b);
+    climb(b, exitB);
+    path.pop_back();
+    std::reverse(path.begin() + static_cast<std::ptrdiff_t>(middle), path.end());
+    return true;
+}
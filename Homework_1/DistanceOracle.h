@@ -0,0 +1,123 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file DistanceOracle.h
+ * @brief Shortest distances and paths between any two cells of a perfect maze without searching
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A perfect maze is a tree, and most of its cells are corridor cells with exactly two open
+ * neighbours. The oracle contracts every corridor into one weighted edge between junctions
+ * (cells with any other number of open neighbours), roots each tree of junctions and splits it
+ * into heavy paths. Every cell then knows its edge and its distance along it, so a query only
+ * has to find the lowest common ancestor of two junctions, which climbs at most O(log n) heavy
+ * paths.
+ */
+
+#ifndef HOMEWORK_1_DISTANCEORACLE_H_
+#define HOMEWORK_1_DISTANCEORACLE_H_
+
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <vector>
+
+/**
+ * @class DistanceOracle
+ * @brief Junction tree of a perfect maze answering distance and path queries
+ *
+ * The oracle keeps a reference to the maze for path queries; changing the walls of the maze
+ * after construction makes its answers invalid.
+ */
+class DistanceOracle
+{
+  public:
+    /**
+     * @brief Contract the maze into its junction tree and index it
+     * @param maze The maze, which must not have loops (mazes from generate() without wall removal)
+     * @throws std::invalid_argument if the open cells of the maze contain a loop
+     */
+    explicit DistanceOracle(const Maze &maze);
+
+    /**
+     * @brief Get the shortest distance between two cells
+     * @param from First cell
+     * @param to Second cell
+     * @return Number of steps, -1 if either cell is a wall or they are not connected
+     */
+    int distance(Position from, Position to) const;
+
+    /**
+     * @brief Get the shortest path between two cells
+     * @param from First cell
+     * @param to Second cell
+     * @param path Receives the cells from from to to, both included (empty if there is no path); its capacity is reused
+     * @return false if either cell is a wall or they are not connected
+     */
+    bool findPath(Position from, Position to, std::vector<Position> &path) const;
+
+    /**
+     * @brief Get the number of junctions, the nodes of the contracted tree
+     */
+    int getJunctionCount() const
+    {
+        return static_cast<int>(m_junction_cell.size());
+    }
+
+  private:
+    const Maze &m_maze;
+    int m_neighbor_offset[4];         // Flat grid offsets of the four neighbours
+    std::vector<int> m_cell_edge;     // Per flat grid index: the junction, or the child junction ending a corridor cell's edge (-1 = wall)
+    std::vector<int> m_cell_offset;   // Per flat grid index: steps from the parent junction along the edge, 0 for junctions
+    std::vector<int> m_junction_cell; // Flat grid index of each junction
+    std::vector<int> m_parent;        // Parent junction, -1 for the root of a tree
+    std::vector<int> m_depth;         // Steps from the root of the tree
+    std::vector<int> m_tree;          // Tree (connected part of the maze) of each junction
+    std::vector<int> m_head;          // Top junction of the heavy path of each junction
+    std::vector<int> m_preorder;      // Position of each junction in a preorder walk of its tree
+    std::vector<int> m_subtree_size;  // Junctions in the subtree of each junction, itself included
+
+    /**
+     * @brief Count the open neighbours of a cell
+     */
+    int degree(int index) const;
+    /**
+     * @brief Walk every corridor from each junction, creating the junction tree one tree at a time
+     * @throws std::invalid_argument if a corridor runs into a cell that was already reached
+     */
+    void contractCorridors();
+    /**
+     * @brief Compute subtree sizes, preorder positions and heavy paths of the junction trees
+     */
+    void buildHeavyPaths();
+    /**
+     * @brief Get the lowest common ancestor of two junctions of the same tree
+     */
+    int lowestCommonAncestor(int u, int v) const;
+    /**
+     * @brief Check if a junction lies in the subtree of another one
+     */
+    bool inSubtree(int junction, int root) const
+    {
+        return m_preorder[junction] >= m_preorder[root] && m_preorder[junction] < m_preorder[root] + m_subtree_size[root];
+    }
+    /**
+     * @brief Get the junction through which a cell leaves its edge toward another cell on a different edge
+     * @param index Flat grid index of the cell
+     * @param other Flat grid index of the other cell
+     * @param steps Receives the distance from the cell to that junction
+     * @return The junction
+     */
+    int exitJunction(int index, int other, int &steps) const;
+    /**
+     * @brief Get the next cell on the way from a cell to the root of its tree (the cell must not be the root)
+     */
+    int towardRoot(int index) const;
+    /**
+     * @brief Get the next cell of a corridor cell's edge in the direction of its child junction
+     */
+    int towardChild(int index) const;
+};
+
+#endif // HOMEWORK_1_DISTANCEORACLE_H_
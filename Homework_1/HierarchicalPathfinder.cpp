@@ -0,0 +1,438 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file HierarchicalPathfinder.cpp
+ * @brief Implementation of the hierarchical path finder
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "HierarchicalPathfinder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <omp.h>
+#include <stdexcept>
+#include <vector>
+
+#define MAX_CLUSTER_SIZE 255        // Largest cluster side; distances inside a cluster must fit in 16 bits
+#define UNREACHABLE_DISTANCE 0xFFFF // Entry of a cluster distance matrix for entrances not connected inside the cluster
+
+HierarchicalPathfinder::HierarchicalPathfinder(const Maze &maze, int clusterSize)
+    : m_maze(maze), m_cluster_size(clusterSize), m_query(0), m_nodes_explored(0)
+{
+    if (clusterSize < 2 || clusterSize > MAX_CLUSTER_SIZE)
+    {
+        throw std::invalid_argument("Cluster size must be between 2 and 255");
+    }
+    m_cluster_rows = (maze.getHeight() + clusterSize - 1) / clusterSize;
+    m_cluster_cols = (maze.getWidth() + clusterSize - 1) / clusterSize;
+    const int clusterCount = m_cluster_rows * m_cluster_cols;
+    m_clusters.resize(clusterCount);
+    m_dirty.assign(clusterCount, 1);
+    m_dirty_clusters.resize(clusterCount);
+    for (int cluster = 0; cluster < clusterCount; ++cluster)
+    {
+        m_dirty_clusters[cluster] = cluster;
+    }
+    refresh();
+}
+
+void HierarchicalPathfinder::clusterBounds(int cluster, int &row, int &col, int &height, int &width) const
+{
+    row = (cluster / m_cluster_cols) * m_cluster_size;
+    col = (cluster % m_cluster_cols) * m_cluster_size;
+    height = std::min(m_cluster_size, m_maze.getHeight() - row);
+    width = std::min(m_cluster_size, m_maze.getWidth() - col);
+}
+
+int HierarchicalPathfinder::positionInCluster(int cluster, int index) const
+{
+    int row, col, height, width;
+    clusterBounds(cluster, row, col, height, width);
+    return (m_maze.rowOf(index) - row) * width + (m_maze.colOf(index) - col);
+}
+
+void HierarchicalPathfinder::searchCluster(int cluster, int root, int target, ClusterSearch &search) const
+{
+    int row, col, height, width;
+    clusterBounds(cluster, row, col, height, width);
+    search.distance.assign(height * width, -1);
+    search.parent.resize(height * width);
+    search.queue.clear();
+
+    const int rootPosition = positionInCluster(cluster, root);
+    const int targetPosition = (target >= 0) ? positionInCluster(cluster, target) : -1;
+    search.distance[rootPosition] = 0;
+    search.parent[rootPosition] = rootPosition;
+    search.queue.push_back(rootPosition);
+    for (std::size_t head = 0; head < search.queue.size(); ++head)
+    {
+        const int current = search.queue[head];
+        if (current == targetPosition)
+        {
+            break;
+        }
+        const int currentRow = current / width;
+        const int currentCol = current % width;
+        const int index = m_maze.cellIndex(row + currentRow, col + currentCol);
+        // Neighbours in the same order as MazeSolver: up, down, left, right
+        const int neighbors[4][3] = {{currentRow > 0, current - width, index - m_maze.getStride()},
+                                     {currentRow + 1 < height, current + width, index + m_maze.getStride()},
+                                     {currentCol > 0, current - 1, index - 1},
+                                     {currentCol + 1 < width, current + 1, index + 1}};
+        for (const int(&neighbor)[3] : neighbors)
+        {
+            if (neighbor[0] && search.distance[neighbor[1]] < 0 && m_maze.isPassable(neighbor[2]))
+            {
+                search.distance[neighbor[1]] = search.distance[current] + 1;
+                search.parent[neighbor[1]] = current;
+                search.queue.push_back(neighbor[1]);
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::buildCluster(int cluster, ClusterSearch &search)
+{
+    Cluster &data = m_clusters[cluster];
+    data.cells.clear();
+    data.links.clear();
+    int row, col, height, width;
+    clusterBounds(cluster, row, col, height, width);
+
+    // Walk each side that faces another cluster and keep the middle pair of every run of open pairs. The cluster across the
+    // side walks the same pairs and keeps the same middle, so both ends of an entrance always exist.
+    const int stride = m_maze.getStride();
+    struct Side
+    {
+        bool exists;
+        int first;  // Inside cell at the start of the side
+        int along;  // Offset to the next inside cell of the side
+        int across; // Offset from an inside cell to the facing cell
+        int length;
+    };
+    const Side sides[4] = {{row > 0, m_maze.cellIndex(row, col), 1, -stride, width},
+                           {row + height < m_maze.getHeight(), m_maze.cellIndex(row + height - 1, col), 1, stride, width},
+                           {col > 0, m_maze.cellIndex(row, col), stride, -1, height},
+                           {col + width < m_maze.getWidth(), m_maze.cellIndex(row, col + width - 1), stride, 1, height}};
+    for (const Side &side : sides)
+    {
+        if (!side.exists)
+        {
+            continue;
+        }
+        int runStart = -1;
+        for (int i = 0; i <= side.length; ++i)
+        {
+            const int inside = side.first + i * side.along;
+            const bool open = i < side.length && m_maze.isPassable(inside) && m_maze.isPassable(inside + side.across);
+            if (open && runStart < 0)
+            {
+                runStart = i;
+            }
+            else if (!open && runStart >= 0)
+            {
+                const int entrance = side.first + ((runStart + i - 1) / 2) * side.along;
+                const int facing = entrance + side.across;
+                data.cells.push_back(entrance);
+                data.links.push_back({entrance, facing, clusterOf(m_maze.rowOf(facing), m_maze.colOf(facing))});
+                runStart = -1;
+            }
+        }
+    }
+
+    // A corner cell can be an entrance on two sides; keep it once and point its links at its position
+    std::sort(data.cells.begin(), data.cells.end());
+    data.cells.erase(std::unique(data.cells.begin(), data.cells.end()), data.cells.end());
+    for (Link &link : data.links)
+    {
+        link.node = static_cast<int>(std::lower_bound(data.cells.begin(), data.cells.end(), link.node) - data.cells.begin());
+    }
+    std::sort(data.links.begin(), data.links.end(), [](const Link &a, const Link &b) { return a.node < b.node; });
+
+    const int entranceCount = static_cast<int>(data.cells.size());
+    data.distance.assign(static_cast<std::size_t>(entranceCount) * entranceCount, UNREACHABLE_DISTANCE);
+    for (int i = 0; i < entranceCount; ++i)
+    {
+        searchCluster(cluster, data.cells[i], -1, search);
+        for (int j = 0; j < entranceCount; ++j)
+        {
+            const int steps = search.distance[positionInCluster(cluster, data.cells[j])];
+            if (steps >= 0)
+            {
+                data.distance[static_cast<std::size_t>(i) * entranceCount + j] = static_cast<std::uint16_t>(steps);
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::refresh()
+{
+    if (m_dirty_clusters.empty())
+    {
+        return;
+    }
+
+    // Clusters only write their own data, so the flagged ones are rebuilt independently
+    const int dirtyCount = static_cast<int>(m_dirty_clusters.size());
+#pragma omp parallel
+    {
+        ClusterSearch search;
+#pragma omp for schedule(dynamic, 16)
+        for (int i = 0; i < dirtyCount; ++i)
+        {
+            buildCluster(m_dirty_clusters[i], search);
+        }
+    }
+    for (int cluster : m_dirty_clusters)
+    {
+        m_dirty[cluster] = 0;
+    }
+    m_dirty_clusters.clear();
+
+    // Entrance counts may have changed, so number the abstract nodes again
+    const int clusterCount = static_cast<int>(m_clusters.size());
+    m_node_start.resize(clusterCount + 1);
+    m_node_start[0] = 0;
+    for (int cluster = 0; cluster < clusterCount; ++cluster)
+    {
+        m_node_start[cluster + 1] = m_node_start[cluster] + static_cast<int>(m_clusters[cluster].cells.size());
+    }
+    const int nodeCount = m_node_start[clusterCount];
+    m_node_cluster.resize(nodeCount);
+    m_node_position.resize(nodeCount + 2);
+    for (int cluster = 0; cluster < clusterCount; ++cluster)
+    {
+        for (int node = m_node_start[cluster]; node < m_node_start[cluster + 1]; ++node)
+        {
+            const int cell = m_clusters[cluster].cells[node - m_node_start[cluster]];
+            m_node_cluster[node] = cluster;
+            m_node_position[node] = {m_maze.rowOf(cell), m_maze.colOf(cell)};
+        }
+    }
+    m_g.resize(nodeCount + 2);
+    m_parent.resize(nodeCount + 2);
+    m_stamp.assign(nodeCount + 2, 0);
+    m_query = 0;
+}
+
+void HierarchicalPathfinder::notifyCellChanged(int row, int col)
+{
+    if (!m_maze.isInBounds(row, col))
+    {
+        return;
+    }
+
+    // A cell on the side of a cluster also decides the entrances of the cluster it faces
+    auto flag = [this](int flagRow, int flagCol) {
+        if (!m_maze.isInBounds(flagRow, flagCol))
+        {
+            return;
+        }
+        const int cluster = clusterOf(flagRow, flagCol);
+        if (!m_dirty[cluster])
+        {
+            m_dirty[cluster] = 1;
+            m_dirty_clusters.push_back(cluster);
+        }
+    };
+    flag(row, col);
+    flag(row - 1, col);
+    flag(row + 1, col);
+    flag(row, col - 1);
+    flag(row, col + 1);
+}
+
+int HierarchicalPathfinder::searchAbstract(int from, int to)
+{
+    const int nodeCount = m_node_start.back();
+    const int startNode = nodeCount;
+    const int goalNode = nodeCount + 1;
+    const int fromCluster = clusterOf(m_maze.rowOf(from), m_maze.colOf(from));
+    const int toCluster = clusterOf(m_maze.rowOf(to), m_maze.colOf(to));
+    m_abstract_path.clear();
+    m_nodes_explored = 0;
+
+    // Connect start and goal to the entrances of their clusters, and to each other when they share one
+    int direct = -1;
+    searchCluster(fromCluster, from, -1, m_search);
+    const Cluster &startCluster = m_clusters[fromCluster];
+    m_start_distance.resize(startCluster.cells.size());
+    for (std::size_t i = 0; i < startCluster.cells.size(); ++i)
+    {
+        m_start_distance[i] = m_search.distance[positionInCluster(fromCluster, startCluster.cells[i])];
+    }
+    if (fromCluster == toCluster)
+    {
+        direct = m_search.distance[positionInCluster(toCluster, to)];
+    }
+    searchCluster(toCluster, to, -1, m_search);
+    const Cluster &goalCluster = m_clusters[toCluster];
+    m_goal_distance.resize(goalCluster.cells.size());
+    for (std::size_t i = 0; i < goalCluster.cells.size(); ++i)
+    {
+        m_goal_distance[i] = m_search.distance[positionInCluster(toCluster, goalCluster.cells[i])];
+    }
+
+    if (++m_query == 0)
+    {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_query = 1;
+    }
+    m_node_position[startNode] = {m_maze.rowOf(from), m_maze.colOf(from)};
+    m_node_position[goalNode] = {m_maze.rowOf(to), m_maze.colOf(to)};
+    const Position goal = m_node_position[goalNode];
+    auto heuristic = [&](int node) {
+        return std::abs(m_node_position[node].row - goal.row) + std::abs(m_node_position[node].col - goal.col);
+    };
+    auto relax = [&](int node, int parent, int g) {
+        if (m_stamp[node] != m_query || g < m_g[node])
+        {
+            m_stamp[node] = m_query;
+            m_g[node] = g;
+            m_parent[node] = parent;
+            m_open.emplace_back(g + heuristic(node), node);
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<std::pair<int, int>>());
+        }
+    };
+
+    // The heuristic is Manhattan distance and every edge costs at least that much, so a node is final when popped
+    m_open.clear();
+    relax(startNode, startNode, 0);
+    while (!m_open.empty())
+    {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<std::pair<int, int>>());
+        const auto [f, node] = m_open.back();
+        m_open.pop_back();
+        const int g = m_g[node];
+        if (f != g + heuristic(node))
+        {
+            continue; // Stale entry, the node was reached again with a lower g
+        }
+        ++m_nodes_explored;
+        if (node == goalNode)
+        {
+            for (int current = goalNode; current != startNode; current = m_parent[current])
+            {
+                m_abstract_path.push_back(current);
+            }
+            m_abstract_path.push_back(startNode);
+            std::reverse(m_abstract_path.begin(), m_abstract_path.end());
+            return g;
+        }
+        if (node == startNode)
+        {
+            for (std::size_t i = 0; i < m_start_distance.size(); ++i)
+            {
+                if (m_start_distance[i] >= 0)
+                {
+                    relax(m_node_start[fromCluster] + static_cast<int>(i), node, g + m_start_distance[i]);
+                }
+            }
+            if (direct >= 0)
+            {
+                relax(goalNode, node, g + direct);
+            }
+            continue;
+        }
+
+        const int cluster = m_node_cluster[node];
+        const Cluster &data = m_clusters[cluster];
+        const int local = node - m_node_start[cluster];
+        const int entranceCount = static_cast<int>(data.cells.size());
+        const std::uint16_t *distances = data.distance.data() + static_cast<std::size_t>(local) * entranceCount;
+        for (int j = 0; j < entranceCount; ++j)
+        {
+            if (j != local && distances[j] != UNREACHABLE_DISTANCE)
+            {
+                relax(m_node_start[cluster] + j, node, g + distances[j]);
+            }
+        }
+        if (cluster == toCluster && m_goal_distance[local] >= 0)
+        {
+            relax(goalNode, node, g + m_goal_distance[local]);
+        }
+        auto link = std::lower_bound(data.links.begin(), data.links.end(), local,
+                                     [](const Link &a, int value) { return a.node < value; });
+        for (; link != data.links.end() && link->node == local; ++link)
+        {
+            const std::vector<int> &facing = m_clusters[link->cluster].cells;
+            const int facingLocal = static_cast<int>(std::lower_bound(facing.begin(), facing.end(), link->cell) - facing.begin());
+            relax(m_node_start[link->cluster] + facingLocal, node, g + 1);
+        }
+    }
+    return -1;
+}
+
+int HierarchicalPathfinder::distance(Position from, Position to)
+{
+    if (!m_maze.isInBounds(from.row, from.col) || !m_maze.isInBounds(to.row, to.col))
+    {
+        return -1;
+    }
+    const int fromIndex = m_maze.cellIndex(from.row, from.col);
+    const int toIndex = m_maze.cellIndex(to.row, to.col);
+    if (!m_maze.isPassable(fromIndex) || !m_maze.isPassable(toIndex))
+    {
+        return -1;
+    }
+    refresh();
+    return searchAbstract(fromIndex, toIndex);
+}
+
+bool HierarchicalPathfinder::findPath(Position from, Position to, std::vector<Position> &path)
+{
+    path.clear();
+    if (distance(from, to) < 0)
+    {
+        return false;
+    }
+
+    // Each abstract edge either joins two cells of one cluster, refined with a search inside it, or steps across a side
+    path.push_back(from);
+    for (std::size_t i = 1; i < m_abstract_path.size(); ++i)
+    {
+        const Position &first = m_node_position[m_abstract_path[i - 1]];
+        const Position &second = m_node_position[m_abstract_path[i]];
+        const int a = m_maze.cellIndex(first.row, first.col);
+        const int b = m_maze.cellIndex(second.row, second.col);
+        const int cluster = clusterOf(m_maze.rowOf(a), m_maze.colOf(a));
+        if (a == b)
+        {
+            continue;
+        }
+        if (cluster != clusterOf(m_maze.rowOf(b), m_maze.colOf(b)))
+        {
+            path.push_back({m_maze.rowOf(b), m_maze.colOf(b)});
+            continue;
+        }
+        searchCluster(cluster, a, b, m_search);
+        int row, col, height, width;
+        clusterBounds(cluster, row, col, height, width);
+        const std::size_t segmentStart = path.size();
+        const int root = positionInCluster(cluster, a);
+        for (int current = positionInCluster(cluster, b); current != root; current = m_search.parent[current])
+        {
+            path.push_back({row + current / width, col + current % width});
+        }
+        std::reverse(path.begin() + segmentStart, path.end());
+    }
+    return true;
+}
+
+std::size_t HierarchicalPathfinder::getMemoryUsage() const
+{
+    std::size_t bytes = m_clusters.capacity() * sizeof(Cluster);
+    for (const Cluster &cluster : m_clusters)
+    {
+        bytes += cluster.cells.capacity() * sizeof(int) + cluster.distance.capacity() * sizeof(std::uint16_t) +
+                 cluster.links.capacity() * sizeof(Link);
+    }
+    bytes += m_dirty.capacity() + (m_dirty_clusters.capacity() + m_node_start.capacity() + m_node_cluster.capacity()) * sizeof(int);
+    bytes += m_node_position.capacity() * sizeof(Position) + (m_g.capacity() + m_parent.capacity()) * sizeof(int);
+    bytes += m_stamp.capacity() * sizeof(std::uint32_t);
+    return bytes;
+}
@@ -0,0 +1,192 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file HierarchicalPathfinder.h
+ * @brief Hierarchical path finding (HPA*) between any two cells of a large maze
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * The grid is cut into square clusters. Wherever open cells face each other across the border
+ * of two clusters, the middle pair of each run of such cells is an entrance; its two cells are
+ * nodes of an abstract graph, joined by a step of cost 1. Inside each cluster the distances
+ * between its entrance cells are found once with a breadth-first search limited to the
+ * cluster. A query connects start and goal to the entrances of their clusters, runs A* on the
+ * small abstract graph and refines each abstract edge into cells with another search limited
+ * to one cluster. Paths cross cluster borders only at entrances, so they can be slightly
+ * longer than the shortest path in open areas; in corridors every run is one cell wide and
+ * the paths are exact.
+ */
+
+#ifndef HOMEWORK_1_HIERARCHICALPATHFINDER_H_
+#define HOMEWORK_1_HIERARCHICALPATHFINDER_H_
+
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class HierarchicalPathfinder
+ * @brief Cluster abstraction of a maze answering path queries with HPA*
+ *
+ * The pathfinder keeps a reference to the maze. After Maze::setCellType, call
+ * notifyCellChanged() for the cell; only the clusters that can see the cell are rebuilt, on
+ * the next query or refresh().
+ */
+class HierarchicalPathfinder
+{
+  public:
+    /**
+     * @brief Cut the maze into clusters and compute the entrances and distances of all of them
+     * The clusters are built in parallel with OpenMP.
+     * @param maze The maze
+     * @param clusterSize Side of a cluster in cells
+     * @throws std::invalid_argument if clusterSize is outside [2, 255]
+     */
+    explicit HierarchicalPathfinder(const Maze &maze, int clusterSize = 16);
+
+    /**
+     * @brief Get the length of the path findPath() would return
+     * @param from First cell
+     * @param to Second cell
+     * @return Number of steps, -1 if either cell is a wall or they are not connected
+     */
+    int distance(Position from, Position to);
+
+    /**
+     * @brief Find a path between two cells
+     * @param from First cell
+     * @param to Second cell
+     * @param path Receives the cells from from to to, both included (empty if there is no path); its capacity is reused
+     * @return false if either cell is a wall or they are not connected
+     */
+    bool findPath(Position from, Position to, std::vector<Position> &path);
+
+    /**
+     * @brief Tell the pathfinder that a cell turned into a wall or stopped being one
+     * @param row Row of the cell
+     * @param col Column of the cell
+     */
+    void notifyCellChanged(int row, int col);
+    /**
+     * @brief Rebuild the clusters flagged by notifyCellChanged() now rather than on the next query
+     * The clusters are rebuilt in parallel and the abstract nodes are numbered again.
+     */
+    void refresh();
+
+    /**
+     * @brief Get the number of clusters
+     */
+    int getClusterCount() const
+    {
+        return static_cast<int>(m_clusters.size());
+    }
+    /**
+     * @brief Get the number of entrance cells, the nodes of the abstract graph
+     */
+    int getNodeCount() const
+    {
+        return m_node_start.empty() ? 0 : m_node_start.back();
+    }
+    /**
+     * @brief Get the number of abstract nodes expanded by the last query
+     */
+    int getNodesExplored() const
+    {
+        return m_nodes_explored;
+    }
+    /**
+     * @brief Get the bytes held by the abstraction (clusters, entrances and the abstract search buffers)
+     */
+    std::size_t getMemoryUsage() const;
+
+  private:
+    // Step from an entrance cell to the facing cell of the neighboring cluster
+    struct Link
+    {
+        int node;    // Entrance cell inside the cluster, as an index into Cluster::cells
+        int cell;    // Flat grid index of the facing cell
+        int cluster; // Cluster of the facing cell
+    };
+
+    struct Cluster
+    {
+        std::vector<int> cells;              // Flat grid indices of the entrance cells, sorted
+        std::vector<std::uint16_t> distance; // cells.size() squared steps between entrance cells inside the cluster
+        std::vector<Link> links;             // Entrances, one or two per entrance cell
+    };
+
+    // Buffers of a search limited to one cluster, indexed by the position of a cell in the cluster
+    struct ClusterSearch
+    {
+        std::vector<int> distance; // Steps from the root, -1 if not reached
+        std::vector<int> parent;   // Position the cell was reached from
+        std::vector<int> queue;
+    };
+
+    const Maze &m_maze;
+    int m_cluster_size;
+    int m_cluster_rows;
+    int m_cluster_cols;
+    std::vector<Cluster> m_clusters;
+    std::vector<std::uint8_t> m_dirty;     // Per cluster: rebuild before the next query
+    std::vector<int> m_dirty_clusters;     // Clusters flagged in m_dirty
+    std::vector<int> m_node_start;         // Abstract node id of the first entrance of each cluster, plus the node count
+    std::vector<int> m_node_cluster;       // Cluster of each abstract node
+    std::vector<Position> m_node_position; // Cell of each abstract node, then of the start and goal of the current query
+
+    // Abstract search state, the two extra nodes after the entrances are start and goal
+    std::vector<int> m_g;                    // Steps from start, valid where m_stamp matches
+    std::vector<int> m_parent;               // Abstract node each node was reached from
+    std::vector<std::uint32_t> m_stamp;      // Query that last reached each node
+    std::uint32_t m_query;                   // Number of the current query
+    std::vector<int> m_start_distance;       // Steps from start to each entrance of its cluster, -1 if not connected inside it
+    std::vector<int> m_goal_distance;        // Steps from each entrance of the goal's cluster to goal
+    std::vector<std::pair<int, int>> m_open; // Heap of (f score, node) of the abstract A*
+    std::vector<int> m_abstract_path;        // Abstract nodes of the last path from start to goal
+    ClusterSearch m_search;                  // Buffers for the searches of queries
+    int m_nodes_explored;
+
+    /**
+     * @brief Get the cluster of a cell
+     */
+    int clusterOf(int row, int col) const
+    {
+        return (row / m_cluster_size) * m_cluster_cols + (col / m_cluster_size);
+    }
+    /**
+     * @brief Get the first row and column and the height and width of a cluster
+     */
+    void clusterBounds(int cluster, int &row, int &col, int &height, int &width) const;
+    /**
+     * @brief Breadth-first search from a cell that stays inside its cluster
+     * @param cluster The cluster
+     * @param root Flat grid index of an open cell of the cluster
+     * @param target Flat grid index of a cell to stop at, -1 to reach the whole cluster
+     * @param search Buffers receiving the distances and parents
+     */
+    void searchCluster(int cluster, int root, int target, ClusterSearch &search) const;
+    /**
+     * @brief Get the position of a cell in the search buffers of its cluster
+     */
+    int positionInCluster(int cluster, int index) const;
+    /**
+     * @brief Find the entrances on the borders of a cluster and the distances between them
+     * @param cluster The cluster
+     * @param search Buffers of the calling thread
+     */
+    void buildCluster(int cluster, ClusterSearch &search);
+    /**
+     * @brief Run A* on the abstract graph extended with two cells
+     * @param from Flat grid index of an open start cell
+     * @param to Flat grid index of an open goal cell
+     * @return Steps of the path, -1 if there is none; the abstract nodes are left in m_abstract_path
+     */
+    int searchAbstract(int from, int to);
+};
+
+#endif // HOMEWORK_1_HIERARCHICALPATHFINDER_H_
@@ -14,17 +14,21 @@ Write a C++ program that generates and visualizes a maze using the SFML library.
 This file is our main entry point that controls the animation loop, event handling, and overall application flow.
 */
 
+#include "MazeFile.h"
 #include "MazeGenerator.h"
 #include "MazeSolver.h"
+#include "SolverThread.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <fcntl.h>
 #include <filesystem>
 #include <iostream>
-#include <list>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <io.h>
@@ -35,7 +39,10 @@ This file is our main entry point that controls the animation loop, event handli
 #define PANEL 250
 #define DEFAULT_MAZE_SIZE 25
 #define MIN_MAZE_SIZE 10
-#define MAX_MAZE_SIZE 100
+#define MAX_MAZE_SIZE 1000             // Largest maze shown in the window
+#define MAX_HEADLESS_MAZE_SIZE 40000   // Largest maze generated with --no-window
+#define MAX_STREAMED_MAZE_SIZE 1000000 // Largest maze streamed to a file with --stream
+#define ALGORITHM_COUNT 9              // Entries of AlgorithmType
 #define DEFAULT_PADDING 10.f
 #define DEFAULT_FONT_SIZE 16
 
@@ -43,21 +50,27 @@ This file is our main entry point that controls the animation loop, event handli
 struct MazeConfig
 {
     // @brief Default constructor initializes maze size to 25x25
-    MazeConfig() : height(DEFAULT_MAZE_SIZE), width(DEFAULT_MAZE_SIZE)
+    MazeConfig()
+        : height(DEFAULT_MAZE_SIZE), width(DEFAULT_MAZE_SIZE), algorithm(GenerationAlgorithm::RecursiveBacktracker), headless(false)
     {
     }
     // @brief Parameterized constructor with validation
     // @param h Maze height
     // @param w Maze width
+    // @param a Maze generation algorithm
+    // @param noWindow Generate without opening a window (allows larger mazes)
+    // @param path File to stream the maze to instead of keeping it in memory (empty to disable)
     // @throws std::invalid_argument if dimensions are out of valid range
-    MazeConfig(int h, int w) : height(h), width(w)
+    MazeConfig(int h, int w, GenerationAlgorithm a = GenerationAlgorithm::RecursiveBacktracker, bool noWindow = false,
+               const std::string &path = "")
+        : height(h), width(w), algorithm(a), headless(noWindow || !path.empty()), streamPath(path)
     {
         if (!isDimensionValid())
         {
-            std::cerr << "Invalid maze dimensions. Height and width must be between " << MIN_MAZE_SIZE << " and " << MAX_MAZE_SIZE << "."
+            std::cerr << "Invalid maze dimensions. Height and width must be between " << MIN_MAZE_SIZE << " and " << getMaxSize() << "."
                       << std::endl;
             throw std::invalid_argument("Invalid maze dimensions. Height and width must be between " + std::to_string(MIN_MAZE_SIZE) +
-                                        " and " + std::to_string(MAX_MAZE_SIZE) + ".");
+                                        " and " + std::to_string(getMaxSize()) + ".");
         }
     }
 
@@ -74,16 +87,96 @@ struct MazeConfig
     {
         return width;
     }
+    // @brief Get maze generation algorithm
+    // @return Maze generation algorithm
+    GenerationAlgorithm getAlgorithm() const
+    {
+        return algorithm;
+    }
+    // @brief Check if the maze is generated without a window
+    // @return True for headless generation
+    bool isHeadless() const
+    {
+        return headless;
+    }
+    // @brief Get the file the maze is streamed to
+    // @return File path, empty when the maze is generated in memory
+    const std::string &getStreamPath() const
+    {
+        return streamPath;
+    }
+    // @brief Get the maze file to open instead of generating a maze
+    // @return File path, empty to generate a new maze
+    const std::string &getLoadPath() const
+    {
+        return loadPath;
+    }
+    // @brief Get the maze file the maze is saved to once it is generated or opened
+    // @return File path, empty to not save the maze
+    const std::string &getSavePath() const
+    {
+        return savePath;
+    }
+    // @brief Set the maze files to open and save
+    // @param load Maze file to open (empty to generate a new maze)
+    // @param save Maze file to save to (empty to not save)
+    void setMazeFiles(const std::string &load, const std::string &save)
+    {
+        loadPath = load;
+        savePath = save;
+    }
+    // @brief Get the percentage of walls knocked out after generating
+    // @return Percentage between 0 (perfect maze) and 100 (open grid)
+    int getWallRemovalPercent() const
+    {
+        return wallRemovalPercent;
+    }
+    // @brief Set the percentage of walls knocked out after generating
+    // @param percent Percentage between 0 and 100
+    void setWallRemovalPercent(int percent)
+    {
+        wallRemovalPercent = percent;
+    }
+    // @brief Get the highest terrain cost laid over the maze
+    // @return Highest cost between 1 and 255, 0 for a maze without terrain
+    int getTerrainMaxCost() const
+    {
+        return terrainMaxCost;
+    }
+    // @brief Set the highest terrain cost laid over the maze
+    // @param maxCost Highest cost between 1 and 255, 0 for a maze without terrain
+    void setTerrainMaxCost(int maxCost)
+    {
+        terrainMaxCost = maxCost;
+    }
 
   private:
     int height;
     int width;
+    GenerationAlgorithm algorithm;
+    bool headless;
+    std::string streamPath;
+    std::string loadPath;
+    std::string savePath;
+    int wallRemovalPercent = 0;
+    int terrainMaxCost = 0;
+
+    // @brief Largest allowed dimension, the window caps it at what can still be drawn
+    // @return Maximum height and width
+    int getMaxSize() const
+    {
+        if (!streamPath.empty())
+        {
+            return MAX_STREAMED_MAZE_SIZE;
+        }
+        return headless ? MAX_HEADLESS_MAZE_SIZE : MAX_MAZE_SIZE;
+    }
 
     // @brief Validate maze dimensions
     // @return True if dimensions are valid, false otherwise
     bool isDimensionValid()
     {
-        return height >= MIN_MAZE_SIZE && height <= MAX_MAZE_SIZE && width >= MIN_MAZE_SIZE && width <= MAX_MAZE_SIZE;
+        return height >= MIN_MAZE_SIZE && height <= getMaxSize() && width >= MIN_MAZE_SIZE && width <= getMaxSize();
     }
 };
 
@@ -91,29 +184,142 @@ struct MazeConfig
 enum class AlgorithmType
 {
     BFS,
-    AStar
+    AStar,
+    BidirectionalBFS,
+    BidirectionalAStar,
+    ParallelBFS,
+    JumpPointSearch,
+    BitboardBFS,
+    LifelongPlanningAStar,
+    Dijkstra
+};
+
+// @brief Where the animated solver takes its steps
+enum class SteppingMode
+{
+    Frame,    // On the render thread between frames, bounded by the frame time
+    Thread,   // On a SolverThread, throttled to the steps per second
+    FullSpeed // On a SolverThread without a throttle
 };
 
 /** @brief Process command line arguments to configure maze dimensions
+ * Usage: Hw1 [height width [algorithm]] [--no-window] [--open percent] [--terrain maxCost] [--stream path] [--load path] [--save path]
  * @param argc Argument count
  * @param argv Argument vector
  * @return MazeConfig object with specified or default dimensions
+ * @throws std::invalid_argument if the algorithm name is unknown, the dimensions are out of range, an option is missing its
+ * file path, --open is not given a percentage between 0 and 100, --terrain is not given a cost between 1 and 255 or --stream
+ * is used with a generator other than Eller's, with --open or with --terrain
  */
 MazeConfig processArgs(int argc, char *argv[])
 {
-    MazeConfig config;
+    // Separate the options from the positional arguments
+    std::vector<std::string> positional;
+    bool headless = false;
+    std::string streamPath;
+    std::string loadPath;
+    std::string savePath;
+    int wallRemovalPercent = 0;
+    int terrainMaxCost = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (option == "--no-window")
+        {
+            headless = true;
+        }
+        else if (option == "--stream" || option == "--load" || option == "--save")
+        {
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument(option + " requires a file path");
+            }
+            std::string &path = (option == "--stream") ? streamPath : (option == "--load") ? loadPath : savePath;
+            path = argv[++i];
+        }
+        else if (option == "--open")
+        {
+            // Knock out this share of the walls after generating, which turns the perfect maze into one with loops and rooms
+            std::size_t parsed = 0;
+            try
+            {
+                if (i + 1 < argc)
+                {
+                    wallRemovalPercent = std::stoi(argv[++i], &parsed);
+                }
+            }
+            catch (const std::exception &)
+            {
+                parsed = 0;
+            }
+            if (parsed == 0 || argv[i][parsed] != '\0' || wallRemovalPercent < 0 || wallRemovalPercent > 100)
+            {
+                throw std::invalid_argument("--open requires a percentage between 0 and 100");
+            }
+        }
+        else if (option == "--terrain")
+        {
+            // Lay patches of random cost over the maze, which the cost-aware solvers route around
+            std::size_t parsed = 0;
+            try
+            {
+                if (i + 1 < argc)
+                {
+                    terrainMaxCost = std::stoi(argv[++i], &parsed);
+                }
+            }
+            catch (const std::exception &)
+            {
+                parsed = 0;
+            }
+            if (parsed == 0 || argv[i][parsed] != '\0' || terrainMaxCost < 1 || terrainMaxCost > 255)
+            {
+                throw std::invalid_argument("--terrain requires a cost between 1 and 255");
+            }
+        }
+        else
+        {
+            positional.emplace_back(argv[i]);
+        }
+    }
+
+    auto makeConfig = [&](int h, int w, GenerationAlgorithm a) {
+        MazeConfig config(h, w, a, headless, streamPath);
+        config.setMazeFiles(loadPath, savePath);
+        config.setWallRemovalPercent(wallRemovalPercent);
+        config.setTerrainMaxCost(terrainMaxCost);
+        return config;
+    };
 
-    // To process arguments, we expect two integers for height and width. If not provided, we use defaults.
-    if (argc != 3)
+    // To process arguments, we expect two integers for height and width and an optional generation algorithm.
+    // If not provided, we use defaults.
+    if (positional.size() != 2 && positional.size() != 3)
     {
         std::cout << "Defaulting to maze size 25x25. To specify size, provide two arguments for height and width (e.g. "
-                     "./maze 30 40)."
+                     "./maze 30 40), optionally followed by a generator (backtracker, wilson, eller, kruskal)."
                   << std::endl;
-        return MazeConfig();
+        GenerationAlgorithm defaultAlgorithm = streamPath.empty() ? GenerationAlgorithm::RecursiveBacktracker : GenerationAlgorithm::Eller;
+        return makeConfig(DEFAULT_MAZE_SIZE, DEFAULT_MAZE_SIZE, defaultAlgorithm);
     }
 
-    char *height = argv[1];
-    char *width = argv[2];
+    // Streaming keeps a single row in memory, which only Eller's algorithm can do
+    GenerationAlgorithm algorithm = (positional.size() == 3) ? parseGenerationAlgorithm(positional[2])
+                                    : streamPath.empty()     ? GenerationAlgorithm::RecursiveBacktracker
+                                                             : GenerationAlgorithm::Eller;
+    if (!streamPath.empty() && algorithm != GenerationAlgorithm::Eller)
+    {
+        throw std::invalid_argument("--stream only supports the eller generator");
+    }
+    if (!streamPath.empty() && wallRemovalPercent > 0)
+    {
+        throw std::invalid_argument("--stream only writes perfect mazes and cannot be combined with --open");
+    }
+    if (!streamPath.empty() && terrainMaxCost > 0)
+    {
+        throw std::invalid_argument("--stream does not keep the maze in memory and cannot be combined with --terrain");
+    }
+    const std::string &height = positional[0];
+    const std::string &width = positional[1];
     int parsedHeight, parsedWidth;
     try
     {
@@ -123,14 +329,91 @@ MazeConfig processArgs(int argc, char *argv[])
     catch (const std::exception &e)
     {
         // throw error with details about the failure and the received arguments
-        std::cerr << "Error parsing Maze dimensions: " + std::string(e.what()) + ".  Received height: " + std::string(height) +
-                         ", width: " + std::string(width)
+        std::cerr << "Error parsing Maze dimensions: " + std::string(e.what()) + ".  Received height: " + height + ", width: " + width
                   << std::endl;
         std::cerr << "Defaulting to maze size 25x25." << std::endl;
-        return MazeConfig();
+        return makeConfig(DEFAULT_MAZE_SIZE, DEFAULT_MAZE_SIZE, algorithm);
+    }
+
+    return makeConfig(parsedHeight, parsedWidth, algorithm);
+}
+
+/** @brief Create the maze to show: opened from a maze file, or an empty maze of the configured size to generate
+ * The terrain, if any, is laid over the maze here; maze files only store walls.
+ * @param config Maze configuration
+ * @return The maze
+ * @throws std::runtime_error if the maze file cannot be opened
+ * @throws std::invalid_argument if an opened maze is too large for the window or the grid
+ */
+std::unique_ptr<Maze> createMaze(const MazeConfig &config)
+{
+    if (config.getLoadPath().empty())
+    {
+        auto maze = std::make_unique<Maze>(config.getHeight(), config.getWidth());
+        std::cout << "Initialized maze with dimensions: " << maze->getWidth() << "x" << maze->getHeight() << std::endl;
+        maze->setWallRemovalPercent(config.getWallRemovalPercent());
+        if (config.getTerrainMaxCost() > 0)
+        {
+            maze->generateTerrain(config.getTerrainMaxCost());
+        }
+        return maze;
     }
 
-    return MazeConfig(parsedHeight, parsedWidth);
+    auto startTime = std::chrono::high_resolution_clock::now();
+    MazeFile file(config.getLoadPath());
+    int maxSize = config.isHeadless() ? MAX_HEADLESS_MAZE_SIZE : MAX_MAZE_SIZE;
+    if (file.getWidth() > static_cast<std::uint64_t>(maxSize) || file.getHeight() > static_cast<std::uint64_t>(maxSize))
+    {
+        throw std::invalid_argument("Maze file " + config.getLoadPath() + " is " + std::to_string(file.getWidth()) + "x" +
+                                    std::to_string(file.getHeight()) + ", the largest maze that can be opened is " +
+                                    std::to_string(maxSize) + "x" + std::to_string(maxSize) +
+                                    " (MazeBenchmark --files solves larger files in place)");
+    }
+    auto maze = std::make_unique<Maze>(file);
+    maze->setWallRemovalPercent(config.getWallRemovalPercent()); // For mazes generated later with G
+    if (config.getTerrainMaxCost() > 0)
+    {
+        maze->generateTerrain(config.getTerrainMaxCost());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    std::cout << "Loaded " << maze->getWidth() << "x" << maze->getHeight() << " maze from " << config.getLoadPath() << " in "
+              << seconds * 1000.0 << " ms" << std::endl;
+    return maze;
+}
+
+/** @brief Generate a new maze and report how long it took
+ * @param maze The maze to generate
+ * @param algorithm Generation algorithm
+ */
+void generateMaze(Maze &maze, GenerationAlgorithm algorithm)
+{
+    maze.generate(algorithm);
+    std::cout << "Generated " << maze.getWidth() << "x" << maze.getHeight() << " maze with " << generationAlgorithmName(algorithm)
+              << " in " << maze.getGenerationSeconds() * 1000.0 << " ms (" << maze.getGenerationThroughput() << " cells/s)" << std::endl;
+}
+
+/** @brief Save the maze if a maze file was requested
+ * @param maze The maze to save
+ * @param path Maze file to create (empty to not save)
+ * @return False if the maze could not be saved
+ */
+bool saveMaze(const Maze &maze, const std::string &path)
+{
+    if (path.empty())
+    {
+        return true;
+    }
+    try
+    {
+        maze.save(path);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "Saved maze to " << path << std::endl;
+    return true;
 }
 
 /** @brief Load a font from the specified file path
@@ -210,7 +493,7 @@ sf::Text getText(sf::Font &font, const std::string &str, unsigned int size, sf::
 
 /** @brief Update the maze solver animation based on elapsed time
  * @param deltaTime Time elapsed since last update
- * @param solving Reference to the boolean indicating if the solver is currently animating
+ * @param solving Reference to the boolean indicating if the solver is currently animating, cleared when the search ended
  * @param solver Reference to the MazeSolver object to perform the next step
  * @param animationSpeed Reference to the animation speed (time per step)
  * @param nodesExploredCount Reference to the nodes explored counter
@@ -233,6 +516,11 @@ void update(sf::Time deltaTime, bool &solving, MazeSolver &solver, const sf::Tim
             break; // Stop running steps if we've found the goal
         }
         elapsedTime += stepClock.getElapsedTime();
+        if (solver.isExhausted())
+        {
+            solving = false;
+            break; // The end cannot be reached
+        }
     }
 
     if (!solving || nodesExploredCount % 10 == 0)
@@ -241,6 +529,61 @@ void update(sf::Time deltaTime, bool &solving, MazeSolver &solver, const sf::Tim
     }
 }
 
+/** @brief Show the latest progress of a solve running on a SolverThread
+ * @param solverThread The thread running the solve
+ * @param maze The maze shown in the window, which receives the cells the solver changed
+ * @param solving Reference to the boolean indicating if the solver is currently animating, cleared when the search ended
+ * @param nodesExploredCount Reference to the nodes explored counter
+ * @param elapsedTime Reference to the sf::Time object representing the time spent in the solver
+ * @return The path once the search ended (empty if the end cannot be reached), nullptr while it runs
+ */
+const std::vector<Position> *updateFromThread(SolverThread &solverThread, Maze &maze, bool &solving, int &nodesExploredCount,
+                                              sf::Time &elapsedTime)
+{
+    const SolverThread::Snapshot *snapshot = solverThread.acquireSnapshot();
+    if (!snapshot)
+    {
+        return nullptr;
+    }
+    const int cellCount = maze.getCellCount();
+    for (int block : snapshot->changedBlocks)
+    {
+        const int first = block << Maze::DIRTY_BLOCK_SHIFT;
+        maze.setCellTypes(first, snapshot->cells.data() + first, std::min(1 << Maze::DIRTY_BLOCK_SHIFT, cellCount - first));
+    }
+    nodesExploredCount = snapshot->nodesExplored;
+    elapsedTime = snapshot->solveTime;
+    if (!snapshot->done)
+    {
+        return nullptr;
+    }
+
+    solving = false;
+    const double seconds = std::max(snapshot->solveTime.asSeconds(), 1e-6f);
+    std::cout << "Solver thread: " << snapshot->nodesExplored << " nodes explored in " << snapshot->steps << " steps, "
+              << snapshot->solveTime.asMicroseconds() << " µs (" << static_cast<long long>(snapshot->steps / seconds) << " steps/s)."
+              << std::endl;
+    return &snapshot->path;
+}
+
+/** @brief Get the text shown for a stepping mode
+ * @param mode The stepping mode
+ * @return Display text
+ */
+std::string getSteppingName(SteppingMode mode)
+{
+    switch (mode)
+    {
+    case SteppingMode::Thread:
+        return "Stepping: Thread";
+    case SteppingMode::FullSpeed:
+        return "Stepping: Full Speed";
+    case SteppingMode::Frame:
+    default:
+        return "Stepping: Frame";
+    }
+}
+
 /** @brief Calculate the animation speed in steps per second and update the animation speed accordingly
  * @param animationSpeed Reference to the sf::Time object representing the current animation speed
  * @param stepsPerSecond Reference to the integer representing the current steps per second
@@ -272,27 +615,100 @@ void calculateStepsPerSecond(sf::Time &animationSpeed, int &stepsPerSecond, bool
               << std::endl;
 }
 
-/** @brief Switch between BFS and A* pathfinding algorithms
+/** @brief Create the solver of an algorithm
+ * @param type The algorithm
+ * @param maze Reference to the maze object
+ * @param workspace Scratch memory shared by the solvers
+ * @return The new solver
+ */
+std::unique_ptr<MazeSolver> createSolver(AlgorithmType type, Maze &maze, SolverWorkspace &workspace)
+{
+    switch (type)
+    {
+    case AlgorithmType::AStar:
+        return std::make_unique<AStarSearch>(maze, OpenSetType::BucketQueue, &workspace);
+    case AlgorithmType::BidirectionalBFS:
+        return std::make_unique<BidirectionalBFS>(maze, &workspace);
+    case AlgorithmType::BidirectionalAStar:
+        return std::make_unique<BidirectionalAStar>(maze, &workspace);
+    case AlgorithmType::ParallelBFS:
+        return std::make_unique<ParallelBFS>(maze, 0, &workspace);
+    case AlgorithmType::JumpPointSearch:
+        return std::make_unique<JumpPointSearch>(maze, &workspace);
+    case AlgorithmType::BitboardBFS:
+        return std::make_unique<BitboardBFS>(maze, &workspace);
+    case AlgorithmType::LifelongPlanningAStar:
+        return std::make_unique<LifelongPlanningAStar>(maze, &workspace);
+    case AlgorithmType::Dijkstra:
+        return std::make_unique<DijkstraSearch>(maze, &workspace);
+    case AlgorithmType::BFS:
+    default:
+        return std::make_unique<BreadthFirstSearch>(maze, &workspace);
+    }
+}
+
+/** @brief Cycle through the pathfinding algorithms: BFS, A*, bidirectional BFS, bidirectional A*, parallel BFS, jump point search,
+ * bitboard BFS, LPA* and Dijkstra
+ * Each solver is created the first time its algorithm comes up and kept, so cycling allocates nothing after the first
+ * round; the caller resets the solver before it searches.
  * @param currentAlgorithm Reference to current algorithm type
- * @param solver Reference to the solver unique_ptr (automatically deleted when reassigned)
+ * @param solvers The solver of each algorithm, indexed by AlgorithmType, empty until first used
+ * @param solver Reference to the pointer to the solver in use
  * @param maze Reference to the maze object
+ * @param workspace Scratch memory shared by the solvers
  * @param algorithm Reference to the algorithm display text
  */
-void switchAlgorithm(AlgorithmType &currentAlgorithm, std::unique_ptr<MazeSolver> &solver, Maze &maze, sf::Text &algorithm)
+void switchAlgorithm(AlgorithmType &currentAlgorithm, std::unique_ptr<MazeSolver> (&solvers)[ALGORITHM_COUNT], MazeSolver *&solver,
+                     Maze &maze, SolverWorkspace &workspace, sf::Text &algorithm)
 {
-    // std::unique_ptr automatically deletes the old solver when reassigned
-    if (currentAlgorithm == AlgorithmType::BFS)
+    std::string name;
+    switch (currentAlgorithm)
     {
+    case AlgorithmType::BFS:
         currentAlgorithm = AlgorithmType::AStar;
-        solver = std::make_unique<AStarSearch>(maze);
-    }
-    else
-    {
+        name = "A*";
+        break;
+    case AlgorithmType::AStar:
+        currentAlgorithm = AlgorithmType::BidirectionalBFS;
+        name = "Bi-BFS";
+        break;
+    case AlgorithmType::BidirectionalBFS:
+        currentAlgorithm = AlgorithmType::BidirectionalAStar;
+        name = "Bi-A*";
+        break;
+    case AlgorithmType::BidirectionalAStar:
+        currentAlgorithm = AlgorithmType::ParallelBFS;
+        name = "Par-BFS";
+        break;
+    case AlgorithmType::ParallelBFS:
+        currentAlgorithm = AlgorithmType::JumpPointSearch;
+        name = "JPS";
+        break;
+    case AlgorithmType::JumpPointSearch:
+        currentAlgorithm = AlgorithmType::BitboardBFS;
+        name = "Bit-BFS";
+        break;
+    case AlgorithmType::BitboardBFS:
+        currentAlgorithm = AlgorithmType::LifelongPlanningAStar;
+        name = "LPA*";
+        break;
+    case AlgorithmType::LifelongPlanningAStar:
+        currentAlgorithm = AlgorithmType::Dijkstra;
+        name = "Dijkstra";
+        break;
+    case AlgorithmType::Dijkstra:
         currentAlgorithm = AlgorithmType::BFS;
-        solver = std::make_unique<BreadthFirstSearch>(maze);
+        name = "BFS";
+        break;
     }
 
-    algorithm.setString("Algorithm: " + std::string(currentAlgorithm == AlgorithmType::BFS ? "BFS" : "A*"));
+    std::unique_ptr<MazeSolver> &pooled = solvers[static_cast<int>(currentAlgorithm)];
+    if (!pooled)
+    {
+        pooled = createSolver(currentAlgorithm, maze, workspace);
+    }
+    solver = pooled.get();
+    algorithm.setString("Algorithm: " + name);
 }
 
 /** @brief Reset the window components to their default state when generating a new maze or resetting the current maze
@@ -350,7 +766,46 @@ int main(int argc, char *argv[])
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
-    Maze maze(config.getHeight(), config.getWidth());
+
+    // Streamed mazes go straight to disk and are never held in memory
+    if (!config.getStreamPath().empty())
+    {
+        try
+        {
+            streamEllerMaze(config.getStreamPath(), config.getWidth(), config.getHeight());
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // An opened maze is shown as it was saved, otherwise a new maze is generated
+    std::unique_ptr<Maze> mazeOwner;
+    try
+    {
+        mazeOwner = createMaze(config);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    Maze &maze = *mazeOwner;
+    const bool loaded = !config.getLoadPath().empty();
+
+    // Headless mode only generates (or opens) the maze, reports the generation throughput and saves it; the solvers are
+    // benchmarked by MazeBenchmark
+    if (config.isHeadless())
+    {
+        if (!loaded)
+        {
+            generateMaze(maze, config.getAlgorithm());
+        }
+        return saveMaze(maze, config.getSavePath()) ? EXIT_SUCCESS : 1;
+    }
 
     // Calculate window size based on maze dimensions and cell size, ensuring it fits within the desktop resolution
     int windowWidth, windowHeight;
@@ -362,10 +817,24 @@ int main(int argc, char *argv[])
     sf::RenderWindow window(sf::VideoMode(windowWidth, windowHeight), "Lab2: Maze Generator By Jennifer Cwagenberg");
     // Set FPS limit to make animation smoother and more consistent across different machines
     window.setFramerateLimit(60);
-    maze.generate();
+    if (!loaded)
+    {
+        generateMaze(maze, config.getAlgorithm());
+    }
+    if (!saveMaze(maze, config.getSavePath()))
+    {
+        return 1;
+    }
     AlgorithmType currentAlgorithm = AlgorithmType::BFS;
-    // Use std::unique_ptr for automatic memory management
-    std::unique_ptr<MazeSolver> solver = std::make_unique<BreadthFirstSearch>(maze);
+    // One solver per algorithm, all searching in the same workspace, so switching and solving again allocate nothing
+    SolverWorkspace workspace;
+    std::unique_ptr<MazeSolver> solvers[ALGORITHM_COUNT];
+    solvers[static_cast<int>(currentAlgorithm)] = createSolver(currentAlgorithm, maze, workspace);
+    MazeSolver *solver = solvers[static_cast<int>(currentAlgorithm)].get();
+    // Solves in the Thread and FullSpeed stepping modes run on solverThread with a solver of their own
+    SteppingMode steppingMode = SteppingMode::Frame;
+    SolverWorkspace threadWorkspace;
+    SolverThread solverThread;
 
     // Panel
     sf::RectangleShape panel({PANEL, static_cast<float>(windowHeight)});
@@ -396,9 +865,12 @@ int main(int argc, char *argv[])
     sf::Text speed = getText(font, "Speed: " + std::to_string(stepsPerSecond) + " STEPS/S", DEFAULT_FONT_SIZE, sf::Color::White,
                              panel_start, diagonal.getGlobalBounds().height + diagonal.getGlobalBounds().top + DEFAULT_PADDING);
 
+    sf::Text stepping = getText(font, getSteppingName(steppingMode), DEFAULT_FONT_SIZE, sf::Color::White, panel_start,
+                                speed.getGlobalBounds().height + speed.getGlobalBounds().top + DEFAULT_PADDING);
+
     // Statistics
     sf::Text statisticsTitle = getText(font, "-- Statistics --", DEFAULT_FONT_SIZE, sf::Color::Green, panel_start,
-                                       speed.getGlobalBounds().height + speed.getGlobalBounds().top + (2 * DEFAULT_PADDING));
+                                       stepping.getGlobalBounds().height + stepping.getGlobalBounds().top + (2 * DEFAULT_PADDING));
     sf::Text nodesExplored =
         getText(font, "Nodes Explored: " + std::to_string(nodesExploredCount), DEFAULT_FONT_SIZE, sf::Color::White, panel_start,
                 statisticsTitle.getGlobalBounds().height + statisticsTitle.getGlobalBounds().top + DEFAULT_PADDING);
@@ -422,8 +894,12 @@ int main(int argc, char *argv[])
                                        reset.getGlobalBounds().height + reset.getGlobalBounds().top + DEFAULT_PADDING);
     sf::Text adjustSpeed = getText(font, "+/-: Adjust Speed", DEFAULT_FONT_SIZE, sf::Color::White, panel_start,
                                    toggleAlgorithm.getGlobalBounds().height + toggleAlgorithm.getGlobalBounds().top + DEFAULT_PADDING);
+    sf::Text toggleStepping = getText(font, "T: Toggle Stepping", DEFAULT_FONT_SIZE, sf::Color::White, panel_start,
+                                      adjustSpeed.getGlobalBounds().height + adjustSpeed.getGlobalBounds().top + DEFAULT_PADDING);
+    sf::Text toggleWall = getText(font, "Click: Toggle Wall", DEFAULT_FONT_SIZE, sf::Color::White, panel_start,
+                                  toggleStepping.getGlobalBounds().height + toggleStepping.getGlobalBounds().top + DEFAULT_PADDING);
     sf::Text escape = getText(font, "ESC: Exit", DEFAULT_FONT_SIZE, sf::Color::White, panel_start,
-                              adjustSpeed.getGlobalBounds().height + adjustSpeed.getGlobalBounds().top + DEFAULT_PADDING);
+                              toggleWall.getGlobalBounds().height + toggleWall.getGlobalBounds().top + DEFAULT_PADDING);
 
     sf::Clock clock;
     bool solving = false;
@@ -443,6 +919,7 @@ int main(int argc, char *argv[])
         window.draw(algorithm);
         window.draw(diagonal);
         window.draw(speed);
+        window.draw(stepping);
 
         // Draw statistics section
         window.draw(statisticsTitle);
@@ -458,30 +935,47 @@ int main(int argc, char *argv[])
         window.draw(reset);
         window.draw(toggleAlgorithm);
         window.draw(adjustSpeed);
+        window.draw(toggleStepping);
+        window.draw(toggleWall);
         window.draw(escape);
 
         // Display rendered content to screen
         window.display();
 
-        // Animate the solver step-by-step based on animation speed
+        // Animate the solver step-by-step based on animation speed, or show how far the solver thread got
         if (solving)
         {
             sf::Time deltaTime = clock.restart();
-            update(deltaTime, solving, *solver, animationSpeed, nodesExploredCount, elapsedTime);
+            const std::vector<Position> *foundPath = nullptr;
+            if (steppingMode == SteppingMode::Frame)
+            {
+                update(deltaTime, solving, *solver, animationSpeed, nodesExploredCount, elapsedTime);
+            }
+            else
+            {
+                foundPath = updateFromThread(solverThread, maze, solving, nodesExploredCount, elapsedTime);
+                nodesExplored.setString("Nodes Explored: " + std::to_string(nodesExploredCount));
+            }
 
             // If the solver just finished, reconstruct and display the solution path
             if (!solving)
             {
                 solved = true;
-                pathFound.setString("Path Found: Yes");
                 nodesExplored.setString("Nodes Explored: " + std::to_string(nodesExploredCount));
                 timeTaken.setString("Time: " + std::to_string(elapsedTime.asMicroseconds()) +
                                     " us"); // using u instead of µ to avoid encoding issues from KOMIKAP_.ttf
 
-                // Reconstruct full path and count steps
-                std::list<Position> path = solver->reconstructPath();
+                // Reconstruct full path and count steps; the solver thread already did
+                static const std::vector<Position> noPath;
+                if (!foundPath)
+                {
+                    foundPath = solver->isExhausted() ? &noPath : &solver->reconstructPath();
+                }
+                const std::vector<Position> &path = *foundPath;
                 pathLengthCount = path.size();
+                pathFound.setString(path.empty() ? "Path Found: No" : "Path Found: Yes");
                 pathLength.setString("Path Length: " + std::to_string(pathLengthCount));
+                solverThread.stop();
             }
         }
         else
@@ -503,8 +997,9 @@ int main(int argc, char *argv[])
                     window.close();
                     break;
                 case sf::Keyboard::A:
-                    // Toggle between BFS and A* algorithms
-                    switchAlgorithm(currentAlgorithm, solver, maze, algorithm);
+                    // Cycle through the solving algorithms
+                    solverThread.stop();
+                    switchAlgorithm(currentAlgorithm, solvers, solver, maze, workspace, algorithm);
                     resetWindowComponents(solved, solving, pathLengthCount, nodesExploredCount, pathFound, nodesExplored, pathLength,
                                           elapsedTime, timeTaken);
                     solver->reset();
@@ -513,7 +1008,8 @@ int main(int argc, char *argv[])
                     break;
                 case sf::Keyboard::G:
                     // Generate a new random maze
-                    maze.generate();
+                    solverThread.stop();
+                    generateMaze(maze, config.getAlgorithm());
                     resetWindowComponents(solved, solving, pathLengthCount, nodesExploredCount, pathFound, nodesExplored, pathLength,
                                           elapsedTime, timeTaken);
                     break;
@@ -521,9 +1017,15 @@ int main(int argc, char *argv[])
                     // Start solving the current maze
                     solving = true;
                     solver->reset();
+                    if (steppingMode != SteppingMode::Frame)
+                    {
+                        solverThread.start(maze, [&](Maze &copy) { return createSolver(currentAlgorithm, copy, threadWorkspace); },
+                                           (steppingMode == SteppingMode::Thread) ? stepsPerSecond : 0);
+                    }
                     break;
                 case sf::Keyboard::R:
                     // Reset the maze visualization (keep maze structure)
+                    solverThread.stop();
                     maze.resetVisualization();
                     maze.draw(window);
                     resetWindowComponents(solved, solving, pathLengthCount, nodesExploredCount, pathFound, nodesExplored, pathLength,
@@ -535,18 +1037,76 @@ int main(int argc, char *argv[])
                     // Increase animation speed
                     calculateStepsPerSecond(animationSpeed, stepsPerSecond, true);
                     speed.setString("Speed: " + std::to_string(stepsPerSecond) + " STEPS/S");
+                    if (steppingMode == SteppingMode::Thread)
+                    {
+                        solverThread.setStepsPerSecond(stepsPerSecond);
+                    }
                     break;
                 case sf::Keyboard::Hyphen:
                 case sf::Keyboard::Subtract:
                     // Decrease animation speed
                     calculateStepsPerSecond(animationSpeed, stepsPerSecond, false);
                     speed.setString("Speed: " + std::to_string(stepsPerSecond) + " STEPS/S");
+                    if (steppingMode == SteppingMode::Thread)
+                    {
+                        solverThread.setStepsPerSecond(stepsPerSecond);
+                    }
+                    break;
+                case sf::Keyboard::T:
+                    // Cycle where the solver steps: between frames, on the solver thread, on the solver thread at full speed
+                    solverThread.stop();
+                    steppingMode = (steppingMode == SteppingMode::Frame)    ? SteppingMode::Thread
+                                   : (steppingMode == SteppingMode::Thread) ? SteppingMode::FullSpeed
+                                                                            : SteppingMode::Frame;
+                    stepping.setString(getSteppingName(steppingMode));
+                    maze.resetVisualization();
+                    resetWindowComponents(solved, solving, pathLengthCount, nodesExploredCount, pathFound, nodesExplored, pathLength,
+                                          elapsedTime, timeTaken);
+                    solver->reset();
                     break;
                 default:
                     break;
                 }
             }
 
+            // Toggle a wall with the left mouse button, start and end stay open
+            int row, col;
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left &&
+                maze.cellAt(event.mouseButton.x, event.mouseButton.y, row, col) && maze.getCellType(row, col) != CellType::Start &&
+                maze.getCellType(row, col) != CellType::End)
+            {
+                // A solve on the solver thread searched a copy of the maze from before the edit, so it is dropped. The thread
+                // also searched with a solver of its own, so the LPA* solver here has no search to repair in those modes.
+                solverThread.stop();
+                maze.setCellType(row, col, (maze.getCellType(row, col) == CellType::Wall) ? CellType::Path : CellType::Wall);
+                if (currentAlgorithm == AlgorithmType::LifelongPlanningAStar && steppingMode == SteppingMode::Frame)
+                {
+                    // LPA* keeps its search: a solved maze is repaired right away, showing only the cells the repair expanded
+                    static_cast<LifelongPlanningAStar &>(*solver).notifyCellChanged(row, col);
+                    if (solved)
+                    {
+                        maze.resetVisualization();
+                        sf::Clock repairClock;
+                        const std::vector<Position> &path = solver->solveMaze();
+                        elapsedTime = repairClock.getElapsedTime();
+                        nodesExploredCount = solver->getNodesExplored();
+                        pathLengthCount = path.size();
+                        pathFound.setString(path.empty() ? "Path Found: No" : "Path Found: Yes");
+                        nodesExplored.setString("Nodes Explored: " + std::to_string(nodesExploredCount));
+                        pathLength.setString("Path Length: " + std::to_string(pathLengthCount));
+                        timeTaken.setString("Time: " + std::to_string(elapsedTime.asMicroseconds()) + " us");
+                    }
+                }
+                else
+                {
+                    // Other solvers have to search again from scratch
+                    maze.resetVisualization();
+                    resetWindowComponents(solved, solving, pathLengthCount, nodesExploredCount, pathFound, nodesExplored, pathLength,
+                                          elapsedTime, timeTaken);
+                    solver->reset();
+                }
+            }
+
             // Handle window close button
             if (event.type == sf::Event::Closed)
                 window.close();
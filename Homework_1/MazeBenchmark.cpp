@@ -0,0 +1,1031 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file MazeBenchmark.cpp
+ * @brief Headless benchmark suite writing generation and solver measurements to CSV
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Builds the MazeBenchmark executable, which needs no window. For every size, generator and
+ * seed it generates the maze, then runs every MazeSolver to completion on it. The --phases
+ * option adds the other path finding structures on the same maze: the parallel BFS at growing
+ * thread counts, the distance oracle, batched path queries, LPA* replanning, HPA* and
+ * cooperative A* for many agents. Each
+ * measurement is preceded by warm-up runs that are not recorded and repeated a number of times,
+ * and each repetition is one CSV row, so regressions can be tracked by diffing or plotting the
+ * file.
+ * By default every run's solver gets its own scratch memory; with --workspace shared they all
+ * search in one SolverWorkspace kept for the whole suite. Maze files given with --files, such as
+ * the ones Hw1 --stream writes, are solved in place by MazeFileBFS without loading them.
+ *
+ * Usage: MazeBenchmark [--sizes 101,501,301x901] [--generators backtracker,wilson,eller,kruskal]
+ *                      [--solvers bfs,astar-heap,...] [--phases solve,parallel-bfs,...]
+ *                      [--seeds 1,2] [--open percent] [--terrain maxCost]
+ *                      [--workspace fresh|shared] [--files a.maze,b.maze]
+ *                      [--repetitions count] [--warmup count] [--csv path]
+ */
+
+#include "CooperativePathfinder.h"
+#include "DistanceOracle.h"
+#include "HierarchicalPathfinder.h"
+#include "MazeFile.h"
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include "PathQueryEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <omp.h>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#define DEFAULT_SIZES "101,501,1001"
+#define DEFAULT_PHASES "solve"
+#define DEFAULT_REPETITIONS 5
+#define DEFAULT_WARMUP 1
+#define DEFAULT_CSV_PATH "maze_benchmark.csv"
+#define CSV_HEADER                                                                                                                       \
+    "phase,generator,height,width,open_percent,terrain_max_cost,seed,solver,workspace,repetition,time_ms,nodes,path_length,path_cost," \
+    "ns_per_node,structure_kb,peak_rss_kb"
+#define ORACLE_QUERIES 100000   // Random distance queries of the oracle phase
+#define BATCH_QUERIES 100000    // Random path queries answered in one batch by the queries phase
+#define BATCH_SOURCES 32        // Distinct start cells shared by those queries
+#define BATCH_PATH_QUERIES 1000 // Queries of the batch answered again with their paths
+#define REPLAN_EDITS 100        // Edits of each kind repaired by LPA* in the replan phase
+#define HPA_QUERIES 1000        // Random path queries of the hpa phase
+#define HPA_EDITS 100           // Cell toggles rebuilt by the hierarchical path finder in the hpa phase
+#define COOP_MIN_AGENTS 16      // Fewest agents routed together by the coop phase
+#define COOP_MAX_AGENTS 1024    // Most agents routed together, doubling from COOP_MIN_AGENTS
+#define COOP_WINDOW 16          // Time steps each cooperative plan looks ahead
+#define COOP_STEPS 1000         // Time steps the agents are moved for
+#define COOP_MEMORY_MB 4096     // The agent count stops doubling once twice the last count's memory would exceed this
+
+// @brief One solver of the suite, by the name used on the command line and in the CSV
+struct SolverEntry
+{
+    std::string name;
+    std::function<std::unique_ptr<MazeSolver>(Maze &, SolverWorkspace *)> create; // Takes nullptr for scratch memory of its own
+};
+
+/** @brief Get every solver the suite can run
+ * @return The solvers, in the order they are benchmarked
+ */
+std::vector<SolverEntry> allSolvers()
+{
+    using Workspace = SolverWorkspace *;
+    return {{"bfs", [](Maze &maze, Workspace workspace) { return std::make_unique<BreadthFirstSearch>(maze, workspace); }},
+            {"astar-heap",
+             [](Maze &maze, Workspace workspace) { return std::make_unique<AStarSearch>(maze, OpenSetType::BinaryHeap, workspace); }},
+            {"astar-bucket",
+             [](Maze &maze, Workspace workspace) { return std::make_unique<AStarSearch>(maze, OpenSetType::BucketQueue, workspace); }},
+            {"bidirectional-bfs", [](Maze &maze, Workspace workspace) { return std::make_unique<BidirectionalBFS>(maze, workspace); }},
+            {"bidirectional-astar", [](Maze &maze, Workspace workspace) { return std::make_unique<BidirectionalAStar>(maze, workspace); }},
+            {"parallel-bfs", [](Maze &maze, Workspace workspace) { return std::make_unique<ParallelBFS>(maze, 0, workspace); }},
+            {"jps", [](Maze &maze, Workspace workspace) { return std::make_unique<JumpPointSearch>(maze, workspace); }},
+            {"bitboard-bfs", [](Maze &maze, Workspace workspace) { return std::make_unique<BitboardBFS>(maze, workspace); }},
+            {"lpa", [](Maze &maze, Workspace workspace) { return std::make_unique<LifelongPlanningAStar>(maze, workspace); }},
+            {"dijkstra", [](Maze &maze, Workspace workspace) { return std::make_unique<DijkstraSearch>(maze, workspace); }}};
+}
+
+/** @brief Reset the peak resident set size so the next reading covers only what runs after this call
+ * Only Linux can reset the peak; elsewhere the reading stays the peak of the whole process.
+ */
+void resetPeakMemory()
+{
+#if defined(__linux__)
+    // Writing 5 to clear_refs sets VmHWM back to the current resident set size (Linux 4.0 and later)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+/** @brief Get the peak resident set size of the process
+ * @return Peak in kilobytes, 0 if it cannot be read
+ */
+long long peakMemoryKB()
+{
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return std::stoll(line.substr(6));
+        }
+    }
+    return 0;
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/** @brief Get the seconds elapsed since a time point
+ * @param start The time point
+ * @return Elapsed seconds
+ */
+double secondsSince(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/** @brief Write one CSV row measured on a generated maze
+ * @param csv The CSV output
+ * @param phase Phase of the measurement
+ * @param prefix The maze settings columns
+ * @param solver Solver or data structure measured
+ * @param workspace fresh or shared for the MazeSolver runs, empty otherwise
+ * @param repetition Repetition number, warm-up runs not counted
+ * @param seconds The time measured
+ * @param nodes Work of the measurement (cells, nodes explored, queries, ...), divided into the time for ns_per_node
+ * @param pathLength Path length in cells, -1 to leave the column empty
+ * @param pathCost Sum of the terrain costs of the path, -1 to leave the column empty
+ * @param structureBytes Bytes held by the data structure measured, -1 to leave the column empty
+ */
+void writeRow(std::ostream &csv, const std::string &phase, const std::string &prefix, const std::string &solver,
+              const std::string &workspace, int repetition, double seconds, long long nodes, long long pathLength, long long pathCost = -1,
+              long long structureBytes = -1)
+{
+    csv << phase << "," << prefix << "," << solver << "," << workspace << "," << repetition << "," << seconds * 1000.0 << "," << nodes
+        << ",";
+    if (pathLength >= 0)
+    {
+        csv << pathLength;
+    }
+    csv << ",";
+    if (pathCost >= 0)
+    {
+        csv << pathCost;
+    }
+    csv << "," << ((nodes > 0) ? seconds * 1e9 / static_cast<double>(nodes) : 0.0) << ",";
+    if (structureBytes >= 0)
+    {
+        csv << structureBytes / 1024;
+    }
+    csv << "," << peakMemoryKB() << std::endl;
+}
+
+/** @brief Draw a random open cell
+ * @param maze The maze, which must have an open cell
+ * @param rng The random number generator
+ * @return The cell
+ */
+Position randomOpenCell(const Maze &maze, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> row(0, maze.getHeight() - 1);
+    std::uniform_int_distribution<int> col(0, maze.getWidth() - 1);
+    Position cell = {row(rng), col(rng)};
+    while (maze.getCellType(cell.row, cell.col) == CellType::Wall)
+    {
+        cell = {row(rng), col(rng)};
+    }
+    return cell;
+}
+
+/** @brief Split a comma-separated list
+ * @param list The list
+ * @return The items, without empty ones
+ */
+std::vector<std::string> splitList(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/** @brief Parse a non-negative integer option value
+ * @param option Name of the option, for the error message
+ * @param value The text to parse
+ * @return The value
+ * @throws std::invalid_argument if the text is not a non-negative integer
+ */
+int parseCount(const std::string &option, const std::string &value)
+{
+    std::size_t parsed = 0;
+    int count = -1;
+    try
+    {
+        count = std::stoi(value, &parsed);
+    }
+    catch (const std::exception &)
+    {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != value.size() || count < 0)
+    {
+        throw std::invalid_argument(option + " requires a non-negative integer, got " + value);
+    }
+    return count;
+}
+
+// @brief Command line settings of the suite
+struct BenchmarkConfig
+{
+    std::vector<std::pair<int, int>> sizes; // Height and width of each maze
+    std::vector<GenerationAlgorithm> generators;
+    std::vector<SolverEntry> solvers;
+    std::vector<unsigned int> seeds;
+    std::vector<std::string> phases; // Measurements on every generated maze besides its generation
+    std::vector<std::string> files;  // Maze files solved in place
+    int wallRemovalPercent = 0;
+    int terrainMaxCost = 0;       // 0 for unit costs
+    bool sharedWorkspace = false; // Solvers search in one workspace kept for the whole suite
+    int repetitions = DEFAULT_REPETITIONS;
+    int warmup = DEFAULT_WARMUP;
+    std::string csvPath = DEFAULT_CSV_PATH;
+};
+
+/** @brief Process the command line arguments
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return The settings, with every list defaulted when its option is missing
+ * @throws std::invalid_argument if an option is unknown, is missing its value or has an invalid value
+ */
+BenchmarkConfig processArgs(int argc, char *argv[])
+{
+    BenchmarkConfig config;
+    std::string sizes;
+    bool sizesGiven = false;
+    std::string generators = "backtracker,wilson,eller,kruskal";
+    std::string solvers;
+    std::string phases = DEFAULT_PHASES;
+    std::string seeds = "1";
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (i + 1 >= argc)
+        {
+            throw std::invalid_argument(option + " requires a value");
+        }
+        const std::string value = argv[++i];
+        if (option == "--sizes")
+        {
+            sizes = value;
+            sizesGiven = true;
+        }
+        else if (option == "--generators")
+        {
+            generators = value;
+        }
+        else if (option == "--solvers")
+        {
+            solvers = value;
+        }
+        else if (option == "--phases")
+        {
+            phases = value;
+        }
+        else if (option == "--seeds")
+        {
+            seeds = value;
+        }
+        else if (option == "--open")
+        {
+            config.wallRemovalPercent = parseCount(option, value);
+            if (config.wallRemovalPercent > 100)
+            {
+                throw std::invalid_argument("--open requires a percentage between 0 and 100");
+            }
+        }
+        else if (option == "--terrain")
+        {
+            config.terrainMaxCost = parseCount(option, value);
+            if (config.terrainMaxCost < 1 || config.terrainMaxCost > 255)
+            {
+                throw std::invalid_argument("--terrain requires a cost between 1 and 255");
+            }
+        }
+        else if (option == "--workspace")
+        {
+            if (value != "fresh" && value != "shared")
+            {
+                throw std::invalid_argument("--workspace requires fresh or shared, got " + value);
+            }
+            config.sharedWorkspace = (value == "shared");
+        }
+        else if (option == "--files")
+        {
+            config.files = splitList(value);
+        }
+        else if (option == "--repetitions")
+        {
+            config.repetitions = parseCount(option, value);
+        }
+        else if (option == "--warmup")
+        {
+            config.warmup = parseCount(option, value);
+        }
+        else if (option == "--csv")
+        {
+            config.csvPath = value;
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option " + option);
+        }
+    }
+
+    // Without --sizes the default mazes are generated, unless only files are to be solved
+    if (!sizesGiven && config.files.empty())
+    {
+        sizes = DEFAULT_SIZES;
+    }
+
+    // A size is either one number for a square maze or height x width
+    for (const std::string &size : splitList(sizes))
+    {
+        const std::size_t separator = size.find('x');
+        const int height = parseCount("--sizes", size.substr(0, separator));
+        const int width = (separator == std::string::npos) ? height : parseCount("--sizes", size.substr(separator + 1));
+        config.sizes.emplace_back(height, width);
+    }
+    for (const std::string &generator : splitList(generators))
+    {
+        config.generators.push_back(parseGenerationAlgorithm(generator));
+    }
+    const std::vector<SolverEntry> available = allSolvers();
+    if (solvers.empty())
+    {
+        config.solvers = available;
+    }
+    for (const std::string &name : splitList(solvers))
+    {
+        auto entry = std::find_if(available.begin(), available.end(), [&name](const SolverEntry &solver) { return solver.name == name; });
+        if (entry == available.end())
+        {
+            throw std::invalid_argument("Unknown solver " + name +
+                                        " (expected bfs, astar-heap, astar-bucket, bidirectional-bfs, bidirectional-astar, "
+                                        "parallel-bfs, jps, bitboard-bfs, lpa or dijkstra)");
+        }
+        config.solvers.push_back(*entry);
+    }
+    for (const std::string &phase : splitList(phases))
+    {
+        if (phase != "solve" && phase != "parallel-bfs" && phase != "oracle" && phase != "queries" && phase != "replan" &&
+            phase != "hpa" && phase != "coop")
+        {
+            throw std::invalid_argument("Unknown phase " + phase + " (expected solve, parallel-bfs, oracle, queries, replan, hpa or coop)");
+        }
+        config.phases.push_back(phase);
+    }
+    for (const std::string &seed : splitList(seeds))
+    {
+        config.seeds.push_back(static_cast<unsigned int>(parseCount("--seeds", seed)));
+    }
+    return config;
+}
+
+/** @brief Run every solver of the suite to completion on a maze, writing one CSV row per repetition
+ * @param config Settings of the suite
+ * @param maze The maze to solve
+ * @param prefix The maze settings columns
+ * @param workspace Scratch memory the solvers share, nullptr to give each run's solver its own
+ * @param csv The CSV output
+ */
+void benchmarkSolvers(const BenchmarkConfig &config, Maze &maze, const std::string &prefix, SolverWorkspace *workspace,
+                      std::ostream &csv)
+{
+    // A fresh solver per run, so every run searches from scratch and its allocations count towards the peak. A shared
+    // workspace only grows when a maze is larger than every one before, so most runs then allocate next to nothing.
+    const char *workspaceName = workspace ? "shared" : "fresh";
+    for (const SolverEntry &entry : config.solvers)
+    {
+        for (int run = 0; run < config.warmup + config.repetitions; ++run)
+        {
+            maze.resetVisualization();
+            resetPeakMemory();
+            std::unique_ptr<MazeSolver> solver = entry.create(maze, workspace);
+            auto startTime = std::chrono::high_resolution_clock::now();
+            const std::vector<Position> &path = solver->solveMaze();
+            double seconds = secondsSince(startTime);
+            if (run < config.warmup)
+            {
+                continue;
+            }
+
+            // Entering every cell but the first costs its terrain cost (1 without terrain); only Dijkstra and A* minimize it
+            long long cost = 0;
+            for (std::size_t i = 1; i < path.size(); ++i)
+            {
+                cost += maze.getCost(maze.cellIndex(path[i].row, path[i].col));
+            }
+            writeRow(csv, "solve", prefix, entry.name, workspaceName, run - config.warmup, seconds, solver->getNodesExplored(),
+                     static_cast<long long>(path.size()), path.empty() ? -1 : cost);
+        }
+    }
+    maze.resetVisualization();
+}
+
+/** @brief Time serial BFS and the parallel BFS with 1, 2, 4, ... threads up to the OpenMP default
+ * The solver column holds the thread count (parallel-bfs-4), so the speedup over the bfs rows can be read off the CSV.
+ * @param config Settings of the suite
+ * @param maze The maze to solve
+ * @param prefix The maze settings columns
+ * @param csv The CSV output
+ */
+void benchmarkParallelBFS(const BenchmarkConfig &config, Maze &maze, const std::string &prefix, std::ostream &csv)
+{
+    // 0 threads stands for serial BFS
+    std::vector<int> threadCounts = {0};
+    const int maxThreads = omp_get_max_threads();
+    for (int threads = 1;; threads = std::min(threads * 2, maxThreads))
+    {
+        threadCounts.push_back(threads);
+        if (threads == maxThreads)
+        {
+            break;
+        }
+    }
+
+    for (int threads : threadCounts)
+    {
+        const std::string name = (threads == 0) ? "bfs" : "parallel-bfs-" + std::to_string(threads);
+        for (int run = 0; run < config.warmup + config.repetitions; ++run)
+        {
+            maze.resetVisualization();
+            resetPeakMemory();
+            std::unique_ptr<MazeSolver> solver;
+            if (threads == 0)
+            {
+                solver = std::make_unique<BreadthFirstSearch>(maze);
+            }
+            else
+            {
+                solver = std::make_unique<ParallelBFS>(maze, threads);
+            }
+            auto startTime = std::chrono::high_resolution_clock::now();
+            const std::size_t pathLength = solver->solveMaze().size();
+            double seconds = secondsSince(startTime);
+            if (run >= config.warmup)
+            {
+                writeRow(csv, "parallel-bfs", prefix, name, "fresh", run - config.warmup, seconds, solver->getNodesExplored(),
+                         static_cast<long long>(pathLength));
+            }
+        }
+    }
+    maze.resetVisualization();
+}
+
+/** @brief Build the distance oracle and time random distance queries against it
+ * Mazes with loops cannot be contracted into a tree, for them the phase writes nothing.
+ * @param config Settings of the suite
+ * @param maze The maze to index
+ * @param prefix The maze settings columns
+ * @param csv The CSV output
+ */
+void benchmarkDistanceOracle(const BenchmarkConfig &config, const Maze &maze, const std::string &prefix, std::ostream &csv)
+{
+    // Queries between random open cells, drawn before timing so only the lookups are measured
+    std::mt19937 rng(1);
+    std::vector<Position> cells(2 * ORACLE_QUERIES);
+    for (Position &cell : cells)
+    {
+        cell = randomOpenCell(maze, rng);
+    }
+    const Position start = {maze.getStart().first, maze.getStart().second};
+    const Position end = {maze.getEnd().first, maze.getEnd().second};
+
+    for (int run = 0; run < config.warmup + config.repetitions; ++run)
+    {
+        resetPeakMemory();
+        auto startTime = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<DistanceOracle> oracle;
+        try
+        {
+            oracle = std::make_unique<DistanceOracle>(maze);
+        }
+        catch (const std::invalid_argument &)
+        {
+            return;
+        }
+        double buildSeconds = secondsSince(startTime);
+
+        startTime = std::chrono::high_resolution_clock::now();
+        long long totalDistance = 0;
+        for (std::size_t i = 0; i < cells.size(); i += 2)
+        {
+            totalDistance += oracle->distance(cells[i], cells[i + 1]);
+        }
+        double querySeconds = secondsSince(startTime);
+        if (run >= config.warmup)
+        {
+            // The start-end path is comparable to the solve rows, the queries report their mean path length
+            writeRow(csv, "oracle-build", prefix, "distance-oracle", "", run - config.warmup, buildSeconds, oracle->getJunctionCount(),
+                     oracle->distance(start, end) + 1);
+            writeRow(csv, "oracle-query", prefix, "distance-oracle", "", run - config.warmup, querySeconds, ORACLE_QUERIES,
+                     (totalDistance / ORACLE_QUERIES) + 1);
+        }
+    }
+}
+
+/** @brief Answer a batch of random path queries with the query engine, first lengths only and then with paths
+ * The queries share a few start cells, so the engine runs one search per start instead of one per query.
+ * @param config Settings of the suite
+ * @param maze The maze to query
+ * @param prefix The maze settings columns
+ * @param csv The CSV output
+ */
+void benchmarkPathQueries(const BenchmarkConfig &config, const Maze &maze, const std::string &prefix, std::ostream &csv)
+{
+    std::mt19937 rng(1);
+    std::vector<Position> sources(BATCH_SOURCES);
+    for (Position &source : sources)
+    {
+        source = randomOpenCell(maze, rng);
+    }
+    std::vector<PathQuery> queries(BATCH_QUERIES);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        queries[i] = {sources[i % sources.size()], randomOpenCell(maze, rng)};
+    }
+    const std::vector<PathQuery> pathQueries(queries.begin(), queries.begin() + BATCH_PATH_QUERIES);
+
+    for (int run = 0; run < config.warmup + config.repetitions; ++run)
+    {
+        resetPeakMemory();
+        PathQueryEngine engine(maze);
+        PathQueryResults results;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        engine.run(queries, results);
+        double seconds = secondsSince(startTime);
+        const long long nodes = engine.getNodesExplored();
+        long long totalLength = 0;
+        for (int length : results.lengths)
+        {
+            totalLength += length;
+        }
+
+        startTime = std::chrono::high_resolution_clock::now();
+        engine.run(pathQueries, results, true);
+        double pathSeconds = secondsSince(startTime);
+        if (run >= config.warmup)
+        {
+            writeRow(csv, "queries", prefix, "query-engine", "", run - config.warmup, seconds, nodes, (totalLength / BATCH_QUERIES) + 1);
+            writeRow(csv, "queries-paths", prefix, "query-engine", "", run - config.warmup, pathSeconds, engine.getNodesExplored(),
+                     static_cast<long long>(results.paths.size() / BATCH_PATH_QUERIES));
+        }
+    }
+}
+
+/** @brief Compare repairing the LPA* search after small edits against solving again from scratch with A*
+ * Two kinds of edits are timed: toggling a random cell anywhere in the maze (replan-toggle), and walling a random cell
+ * of the current path, which forces a detour (replan-path). Every edit is undone right after, so the maze is left as
+ * it was found. The times and nodes of a row add up all the repairs, or all the A* solves, of one kind.
+ * @param config Settings of the suite
+ * @param maze The maze to edit
+ * @param prefix The maze settings columns
+ * @param csv The CSV output
+ */
+void benchmarkReplanning(const BenchmarkConfig &config, Maze &maze, const std::string &prefix, std::ostream &csv)
+{
+    const Position start = {maze.getStart().first, maze.getStart().second};
+    const Position end = {maze.getEnd().first, maze.getEnd().second};
+    for (int run = 0; run < config.warmup + config.repetitions; ++run)
+    {
+        maze.resetVisualization();
+        resetPeakMemory();
+        LifelongPlanningAStar lpa(maze);
+        AStarSearch astar(maze);
+        std::vector<Position> path = lpa.solveMaze();
+
+        // The same edits in every run
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<int> row(0, maze.getHeight() - 1);
+        std::uniform_int_distribution<int> col(0, maze.getWidth() - 1);
+        for (bool onPath : {false, true})
+        {
+            double repairSeconds = 0.0, scratchSeconds = 0.0;
+            long long repairNodes = 0, scratchNodes = 0;
+            int mismatches = 0;
+            for (int edit = 0; edit < REPLAN_EDITS && path.size() > 2; ++edit)
+            {
+                Position cell = onPath ? path[1 + rng() % (path.size() - 2)] : Position{row(rng), col(rng)};
+                if (cell == start || cell == end)
+                {
+                    continue;
+                }
+
+                // Apply the edit and undo it, timing both solvers after each change
+                const CellType original = (maze.getCellType(cell.row, cell.col) == CellType::Wall) ? CellType::Wall : CellType::Path;
+                for (CellType type : {(original == CellType::Wall) ? CellType::Path : CellType::Wall, original})
+                {
+                    maze.setCellType(cell.row, cell.col, type);
+                    lpa.notifyCellChanged(cell.row, cell.col);
+                    maze.resetVisualization();
+                    auto startTime = std::chrono::high_resolution_clock::now();
+                    std::size_t repairedLength = lpa.solveMaze().size();
+                    repairSeconds += secondsSince(startTime);
+                    repairNodes += lpa.getNodesExplored();
+
+                    maze.resetVisualization();
+                    startTime = std::chrono::high_resolution_clock::now();
+                    astar.reset();
+                    std::size_t scratchLength = astar.solveMaze().size();
+                    scratchSeconds += secondsSince(startTime);
+                    scratchNodes += astar.getNodesExplored();
+                    mismatches += (repairedLength != scratchLength) ? 1 : 0;
+                }
+                path = lpa.reconstructPath();
+            }
+
+            // With terrain A* minimizes the cost and LPA* the steps, so only unit costs must give the same lengths
+            if (mismatches > 0 && !maze.hasTerrain())
+            {
+                std::cerr << "Warning: " << mismatches << " LPA* repairs differ in length from A* on " << prefix << std::endl;
+            }
+            if (run >= config.warmup)
+            {
+                const char *phase = onPath ? "replan-path" : "replan-toggle";
+                writeRow(csv, phase, prefix, "lpa", "", run - config.warmup, repairSeconds, repairNodes,
+                         static_cast<long long>(path.size()));
+                writeRow(csv, phase, prefix, "astar", "", run - config.warmup, scratchSeconds, scratchNodes,
+                         static_cast<long long>(path.size()));
+            }
+        }
+    }
+    maze.resetVisualization();
+}
+
+/** @brief Build the hierarchical path finder, time queries with paths and local rebuilds after cell toggles
+ * The start-end query is timed against A* on the same maze (hpa-start-end), and the random queries against their exact
+ * lengths from the path query engine (hpa-query); HPA* paths longer than the exact ones are expected in open areas,
+ * shorter ones are reported. Every toggle is undone right after, so the maze is left as it was found.
+ * @param config Settings of the suite
+ * @param maze The maze to index
+ * @param prefix The maze settings columns
+ * @param csv The CSV output
+ */
+void benchmarkHierarchicalPathfinder(const BenchmarkConfig &config, Maze &maze, const std::string &prefix, std::ostream &csv)
+{
+    // Queries between random open cells and the toggled cells, drawn before timing so only the path finder is measured
+    std::mt19937 rng(1);
+    std::vector<PathQuery> queries(HPA_QUERIES);
+    for (PathQuery &query : queries)
+    {
+        query = {randomOpenCell(maze, rng), randomOpenCell(maze, rng)};
+    }
+    const Position start = {maze.getStart().first, maze.getStart().second};
+    const Position end = {maze.getEnd().first, maze.getEnd().second};
+    std::uniform_int_distribution<int> row(0, maze.getHeight() - 1);
+    std::uniform_int_distribution<int> col(0, maze.getWidth() - 1);
+    std::vector<Position> toggles;
+    for (int edit = 0; edit < HPA_EDITS; ++edit)
+    {
+        Position cell = {row(rng), col(rng)};
+        if (cell != start && cell != end)
+        {
+            toggles.push_back(cell);
+        }
+    }
+
+    maze.resetVisualization();
+    PathQueryEngine engine(maze);
+    PathQueryResults exact;
+    std::vector<Position> path;
+    for (int run = 0; run < config.warmup + config.repetitions; ++run)
+    {
+        resetPeakMemory();
+        auto startTime = std::chrono::high_resolution_clock::now();
+        HierarchicalPathfinder pathfinder(maze);
+        double buildSeconds = secondsSince(startTime);
+
+        startTime = std::chrono::high_resolution_clock::now();
+        pathfinder.findPath(start, end, path);
+        double startEndSeconds = secondsSince(startTime);
+        const long long startEndLength = static_cast<long long>(path.size());
+        const int abstractNodes = pathfinder.getNodesExplored();
+        AStarSearch astar(maze);
+        startTime = std::chrono::high_resolution_clock::now();
+        const long long astarLength = static_cast<long long>(astar.solveMaze().size());
+        double astarSeconds = secondsSince(startTime);
+        maze.resetVisualization();
+
+        startTime = std::chrono::high_resolution_clock::now();
+        std::vector<long long> lengths(queries.size());
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            pathfinder.findPath(queries[i].start, queries[i].goal, path);
+            lengths[i] = static_cast<long long>(path.size());
+        }
+        double querySeconds = secondsSince(startTime);
+
+        // The engine gives the exact steps of every query, -1 where the cells are not connected
+        startTime = std::chrono::high_resolution_clock::now();
+        engine.run(queries, exact);
+        double exactSeconds = secondsSince(startTime);
+        long long totalLength = 0, exactLength = 0;
+        int mismatches = 0;
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            totalLength += lengths[i];
+            exactLength += exact.lengths[i] + 1;
+            mismatches += (lengths[i] < exact.lengths[i] + 1 || (lengths[i] == 0) != (exact.lengths[i] < 0)) ? 1 : 0;
+        }
+        if (mismatches > 0)
+        {
+            std::cerr << "Warning: " << mismatches << " HPA* paths are shorter than the shortest or disagree on connectivity on "
+                      << prefix << std::endl;
+        }
+
+        // A toggle only rebuilds the clusters that can see the cell
+        double editSeconds = 0.0;
+        for (const Position &cell : toggles)
+        {
+            const CellType original = (maze.getCellType(cell.row, cell.col) == CellType::Wall) ? CellType::Wall : CellType::Path;
+            for (CellType type : {(original == CellType::Wall) ? CellType::Path : CellType::Wall, original})
+            {
+                maze.setCellType(cell.row, cell.col, type);
+                startTime = std::chrono::high_resolution_clock::now();
+                pathfinder.notifyCellChanged(cell.row, cell.col);
+                pathfinder.refresh();
+                editSeconds += secondsSince(startTime);
+            }
+        }
+        if (run >= config.warmup)
+        {
+            const int repetition = run - config.warmup;
+            writeRow(csv, "hpa-build", prefix, "hpa", "", repetition, buildSeconds, pathfinder.getNodeCount(), -1, -1,
+                     static_cast<long long>(pathfinder.getMemoryUsage()));
+            writeRow(csv, "hpa-start-end", prefix, "hpa", "", repetition, startEndSeconds, abstractNodes, startEndLength);
+            writeRow(csv, "hpa-start-end", prefix, "astar", "", repetition, astarSeconds, astar.getNodesExplored(), astarLength);
+            writeRow(csv, "hpa-query", prefix, "hpa", "", repetition, querySeconds, HPA_QUERIES, totalLength / HPA_QUERIES);
+            writeRow(csv, "hpa-query", prefix, "query-engine", "", repetition, exactSeconds, HPA_QUERIES, exactLength / HPA_QUERIES);
+            writeRow(csv, "hpa-edit", prefix, "hpa", "", repetition, editSeconds, 2 * static_cast<long long>(toggles.size()), -1);
+        }
+    }
+}
+
+/** @brief Route growing numbers of agents through the maze together with cooperative A*
+ * Each agent gets a random start and goal connected to the start of the maze. The agent count doubles up to
+ * COOP_MAX_AGENTS, as long as the maze has enough connected cells and the reverse searches of the last count, doubled,
+ * fit in COOP_MEMORY_MB; counts left out are logged. The solver column holds
+ * the agent count (cooperative-64)
+ * and the time is spent planning, so ns_per_node is the time per agent plan; a coop-heuristic row gives the time spent
+ * on the distances to the goals, per agent.
+ * @param config Settings of the suite
+ * @param maze The maze to route the agents through
+ * @param prefix The maze settings columns
+ * @param csv The CSV output
+ */
+void benchmarkCooperativePathfinding(const BenchmarkConfig &config, const Maze &maze, const std::string &prefix, std::ostream &csv)
+{
+    const long long cellCount = maze.getCellCount();
+
+    // Random open cells, kept if connected to the start of the maze so every goal can be reached; starts and goals are distinct
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> row(0, maze.getHeight() - 1);
+    std::uniform_int_distribution<int> col(0, maze.getWidth() - 1);
+    const Position mazeStart = {maze.getStart().first, maze.getStart().second};
+    std::vector<PathQuery> candidates(8 * COOP_MAX_AGENTS);
+    for (PathQuery &candidate : candidates)
+    {
+        candidate = {mazeStart, {row(rng), col(rng)}};
+    }
+    PathQueryEngine engine(maze);
+    PathQueryResults results;
+    engine.run(candidates, results);
+    std::vector<Position> cells;
+    std::vector<std::uint8_t> taken(cellCount, 0);
+    for (std::size_t i = 0; i < candidates.size() && cells.size() < 2 * static_cast<std::size_t>(COOP_MAX_AGENTS); ++i)
+    {
+        const int index = maze.cellIndex(candidates[i].goal.row, candidates[i].goal.col);
+        if (results.lengths[i] >= 0 && !taken[index])
+        {
+            taken[index] = 1;
+            cells.push_back(candidates[i].goal);
+        }
+    }
+
+    std::vector<std::vector<Position>> paths;
+    std::size_t memoryUsage = 0;
+    for (int agentCount = COOP_MIN_AGENTS; agentCount <= COOP_MAX_AGENTS; agentCount *= 2)
+    {
+        if (2 * agentCount > static_cast<int>(cells.size()))
+        {
+            std::cerr << "Cooperative A* skipped from " << agentCount << " agents: only " << cells.size()
+                      << " distinct open cells connected to the start were drawn on " << prefix << std::endl;
+            break;
+        }
+        if (2 * memoryUsage > COOP_MEMORY_MB * 1024ull * 1024ull)
+        {
+            std::cerr << "Cooperative A* skipped from " << agentCount << " agents: " << agentCount / 2 << " agents used "
+                      << memoryUsage / (1024 * 1024) << " MB of the " << COOP_MEMORY_MB << " MB budget on " << prefix << std::endl;
+            break;
+        }
+        std::vector<PathQuery> agents(agentCount);
+        for (int i = 0; i < agentCount; ++i)
+        {
+            agents[i] = {cells[2 * i], cells[2 * i + 1]};
+        }
+        const std::string name = "cooperative-" + std::to_string(agentCount);
+        for (int run = 0; run < config.warmup + config.repetitions; ++run)
+        {
+            resetPeakMemory();
+            CooperativePathfinder pathfinder(maze, COOP_WINDOW);
+            pathfinder.route(agents, paths, COOP_STEPS);
+            memoryUsage = pathfinder.getMemoryUsage();
+            if (run >= config.warmup)
+            {
+                writeRow(csv, "coop", prefix, name, "", run - config.warmup, pathfinder.getPlanSeconds(), pathfinder.getPlanCount(), -1, -1,
+                         static_cast<long long>(memoryUsage));
+                writeRow(csv, "coop-heuristic", prefix, name, "", run - config.warmup, pathfinder.getHeuristicSeconds(), agentCount, -1);
+            }
+        }
+    }
+}
+
+/** @brief Benchmark the generation of one maze and every phase on it, writing one CSV row per repetition
+ * @param config Settings of the suite
+ * @param height Requested height (made odd by the maze)
+ * @param width Requested width (made odd by the maze)
+ * @param generator Generation algorithm
+ * @param seed Seed of the maze, the same maze is generated for every repetition
+ * @param workspace Scratch memory the solvers share, nullptr to give each run's solver its own
+ * @param csv The CSV output
+ */
+void benchmarkMaze(const BenchmarkConfig &config, int height, int width, GenerationAlgorithm generator, unsigned int seed,
+                   SolverWorkspace *workspace, std::ostream &csv)
+{
+    std::unique_ptr<Maze> maze;
+    std::string prefix;
+    for (int run = 0; run < config.warmup + config.repetitions; ++run)
+    {
+        maze.reset();
+        resetPeakMemory();
+        maze = std::make_unique<Maze>(width, height, seed);
+        maze->setWallRemovalPercent(config.wallRemovalPercent);
+        maze->generate(generator);
+        const double seconds = maze->getGenerationSeconds();
+        if (config.terrainMaxCost > 0)
+        {
+            maze->generateTerrain(config.terrainMaxCost);
+        }
+        if (run < config.warmup)
+        {
+            continue;
+        }
+        const long long cells = static_cast<long long>(maze->getHeight()) * maze->getWidth();
+        std::ostringstream row;
+        row << generationAlgorithmName(generator) << "," << maze->getHeight() << "," << maze->getWidth() << ","
+            << config.wallRemovalPercent << "," << config.terrainMaxCost << "," << seed;
+        prefix = row.str();
+        writeRow(csv, "generate", prefix, "", "", run - config.warmup, seconds, cells, -1);
+    }
+
+    for (const std::string &phase : config.phases)
+    {
+        if (phase == "solve")
+        {
+            benchmarkSolvers(config, *maze, prefix, workspace, csv);
+        }
+        else if (phase == "parallel-bfs")
+        {
+            benchmarkParallelBFS(config, *maze, prefix, csv);
+        }
+        else if (phase == "oracle")
+        {
+            benchmarkDistanceOracle(config, *maze, prefix, csv);
+        }
+        else if (phase == "queries")
+        {
+            benchmarkPathQueries(config, *maze, prefix, csv);
+        }
+        else if (phase == "replan")
+        {
+            benchmarkReplanning(config, *maze, prefix, csv);
+        }
+        else if (phase == "hpa")
+        {
+            benchmarkHierarchicalPathfinder(config, *maze, prefix, csv);
+        }
+        else if (phase == "coop")
+        {
+            benchmarkCooperativePathfinding(config, *maze, prefix, csv);
+        }
+    }
+}
+
+/** @brief Benchmark MazeFileBFS on a maze file, writing one CSV row per repetition
+ * The file stays mapped for every run, so only the first one reads its rows from disk.
+ * @param config Settings of the suite
+ * @param path The maze file, written in the generator column
+ * @param csv The CSV output
+ */
+void benchmarkFile(const BenchmarkConfig &config, const std::string &path, std::ostream &csv)
+{
+    MazeFile file(path);
+    for (int run = 0; run < config.warmup + config.repetitions; ++run)
+    {
+        resetPeakMemory();
+        MazeFileBFS solver(file);
+        auto startTime = std::chrono::high_resolution_clock::now();
+        const std::size_t pathLength = solver.solveMaze().size();
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+        if (run < config.warmup)
+        {
+            continue;
+        }
+        const std::uint64_t nodes = solver.getNodesExplored();
+        csv << "solve-file," << path << "," << file.getHeight() << "," << file.getWidth() << ",,,,file-bfs,," << run - config.warmup
+            << "," << seconds * 1000.0 << "," << nodes << "," << pathLength << ","
+            << ((nodes > 0) ? seconds * 1e9 / static_cast<double>(nodes) : 0.0) << "," << peakMemoryKB() << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkConfig config;
+    try
+    {
+        config = processArgs(argc, argv);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (config.repetitions == 0 || ((config.sizes.empty() || config.generators.empty() || config.seeds.empty()) && config.files.empty()))
+    {
+        std::cerr << "Error: nothing to benchmark" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream csv(config.csvPath);
+    if (!csv)
+    {
+        std::cerr << "Error: cannot write " << config.csvPath << std::endl;
+        return EXIT_FAILURE;
+    }
+    csv << CSV_HEADER << std::endl;
+    SolverWorkspace workspace; // Used with --workspace shared
+    for (const auto &[height, width] : config.sizes)
+    {
+        for (GenerationAlgorithm generator : config.generators)
+        {
+            for (unsigned int seed : config.seeds)
+            {
+                try
+                {
+                    benchmarkMaze(config, height, width, generator, seed, config.sharedWorkspace ? &workspace : nullptr, csv);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "Error: " << height << "x" << width << " " << generationAlgorithmName(generator) << " seed " << seed
+                              << ": " << e.what() << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
+    for (const std::string &path : config.files)
+    {
+        try
+        {
+            benchmarkFile(config, path, csv);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "Wrote " << config.csvPath << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,444 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file MazeFile.cpp
+ * @brief Implementation of the maze file writer, the memory-mapped reader, its BFS and Eller's algorithm streamed to disk
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "MazeFile.h"
+#include "MazeGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#define MIN_MAZE_DIMENSION 11                             // Same minimum as Maze
+#define MAZE_FILE_BUFFER_SIZE (1u << 20)                  // Bytes buffered between writes
+#define ROOM_BITS 0xAAAAAAAAAAAAAAAAull                   // Every odd column of a word, the rooms of a room row
+#define NO_WORD std::numeric_limits<std::uint64_t>::max() // Word index past every merged list of MazeFileBFS
+
+/**
+ * @brief Count the set bits of a word
+ * @param bits Any word
+ * @return Number of set bits
+ */
+static int countSetBits(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(bits));
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
+
+MazeFileWriter::MazeFileWriter(const std::string &path, std::uint64_t width, std::uint64_t height,
+                               std::pair<std::uint64_t, std::uint64_t> start, std::pair<std::uint64_t, std::uint64_t> end)
+    : m_path(path), m_buffer(MAZE_FILE_BUFFER_SIZE), m_row_words(mazeFileRowWords(width)), m_height(height), m_rows_written(0)
+{
+    // The buffer has to be installed before the file is opened to take effect
+    m_out.rdbuf()->pubsetbuf(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out)
+    {
+        throw std::runtime_error("Cannot create maze file " + path);
+    }
+
+    MazeFileHeader header{};
+    std::memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic));
+    header.version = MAZE_FILE_VERSION;
+    header.byteOrder = MAZE_FILE_BYTE_ORDER;
+    header.width = width;
+    header.height = height;
+    header.startRow = start.first;
+    header.startCol = start.second;
+    header.endRow = end.first;
+    header.endCol = end.second;
+    m_out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void MazeFileWriter::writeRow(const std::uint64_t *bits)
+{
+    if (m_rows_written == m_height)
+    {
+        throw std::runtime_error("Too many rows written to maze file " + m_path);
+    }
+    m_out.write(reinterpret_cast<const char *>(bits), static_cast<std::streamsize>(m_row_words * sizeof(std::uint64_t)));
+    if (!m_out)
+    {
+        throw std::runtime_error("Cannot write maze file " + m_path);
+    }
+    ++m_rows_written;
+}
+
+void MazeFileWriter::finish()
+{
+    if (m_rows_written != m_height)
+    {
+        throw std::runtime_error("Maze file " + m_path + " is missing " + std::to_string(m_height - m_rows_written) + " rows");
+    }
+    m_out.close();
+    if (!m_out)
+    {
+        throw std::runtime_error("Cannot write maze file " + m_path);
+    }
+}
+
+MazeFile::MazeFile(const std::string &path) : m_data(nullptr), m_size(0), m_header{}, m_rows(nullptr), m_row_words(0)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Cannot open maze file " + path);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(MazeFileHeader)))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Maze file " + path + " is too small to hold a header");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The view keeps the file and the mapping object alive, so both handles can be closed right away
+    void *view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping != nullptr)
+    {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (view == nullptr)
+    {
+        throw std::runtime_error("Cannot map maze file " + path);
+    }
+    m_data = static_cast<const unsigned char *>(view);
+    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot open maze file " + path);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(MazeFileHeader)))
+    {
+        close(fd);
+        throw std::runtime_error("Maze file " + path + " is too small to hold a header");
+    }
+    // The mapping stays valid after the descriptor is closed
+    void *view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        throw std::runtime_error("Cannot map maze file " + path);
+    }
+    m_data = static_cast<const unsigned char *>(view);
+    m_size = static_cast<std::size_t>(status.st_size);
+#endif
+
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    std::string error;
+    if (std::memcmp(m_header.magic, MAZE_FILE_MAGIC, sizeof(m_header.magic)) != 0)
+    {
+        error = "is not a maze file";
+    }
+    else if (m_header.version != MAZE_FILE_VERSION)
+    {
+        error = "has unsupported version " + std::to_string(m_header.version);
+    }
+    else if (m_header.byteOrder != MAZE_FILE_BYTE_ORDER)
+    {
+        error = "was written on a host with a different byte order";
+    }
+    else if (m_header.width == 0 || m_header.height == 0)
+    {
+        error = "has no cells";
+    }
+    else if (m_header.width > (m_size - sizeof(MazeFileHeader)) * 8)
+    {
+        // Checked before the row size is computed, which would wrap around for widths close to 2^64
+        error = "is truncated";
+    }
+    else if (m_header.height > (m_size - sizeof(MazeFileHeader)) / (mazeFileRowWords(m_header.width) * sizeof(std::uint64_t)))
+    {
+        error = "is truncated";
+    }
+    else if (m_header.startRow >= m_header.height || m_header.startCol >= m_header.width || m_header.endRow >= m_header.height ||
+             m_header.endCol >= m_header.width)
+    {
+        error = "has its start or end outside the maze";
+    }
+    if (!error.empty())
+    {
+        unmap();
+        throw std::runtime_error("Maze file " + path + " " + error);
+    }
+
+    m_row_words = mazeFileRowWords(m_header.width);
+    m_rows = reinterpret_cast<const std::uint64_t *>(m_data + sizeof(MazeFileHeader));
+}
+
+MazeFile::~MazeFile()
+{
+    unmap();
+}
+
+void MazeFile::unmap()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_rows = nullptr;
+}
+
+MazeFileBFS::MazeFileBFS(const MazeFile &file) : m_file(file), m_row_words(file.getRowWords()), m_nodes_explored(0)
+{
+}
+
+int MazeFileBFS::labelOf(std::uint64_t row, std::uint64_t col) const
+{
+    const std::uint64_t word = (row * m_row_words) + (col / 64);
+    const int bit = static_cast<int>(col % 64);
+    return static_cast<int>((((m_label_high[word] >> bit) & 1u) << 1) | ((m_label_low[word] >> bit) & 1u));
+}
+
+const std::vector<std::pair<std::uint64_t, std::uint64_t>> &MazeFileBFS::solveMaze()
+{
+    // The rows are stored back to back, so word w of the cell data is word w % m_row_words of row w / m_row_words
+    const std::uint64_t *open = m_file.getRow(0);
+    const std::uint64_t words = m_row_words * m_file.getHeight();
+    const std::uint64_t width = m_file.getWidth();
+    const std::uint64_t lastWordMask = (width % 64 == 0) ? ~0ull : ((1ull << (width % 64)) - 1);
+    m_label_low.assign(words, 0);
+    m_label_high.assign(words, 0);
+    m_path.clear();
+    m_nodes_explored = 0;
+
+    const auto [startRow, startCol] = m_file.getStart();
+    const auto [endRow, endCol] = m_file.getEnd();
+    const std::uint64_t startWord = (startRow * m_row_words) + (startCol / 64);
+    const std::uint64_t endWord = (endRow * m_row_words) + (endCol / 64);
+    const std::uint64_t endMask = 1ull << (endCol % 64);
+    m_label_low[startWord] = 1ull << (startCol % 64); // Label 1, layer 0
+    m_layer.assign(1, {startWord, 1ull << (startCol % 64)});
+
+    int label = 1;
+    bool found = (startWord == endWord && (m_label_low[endWord] & endMask) != 0);
+    while (!found && !m_layer.empty())
+    {
+        // Spread every word of the layer within its row. Unlike a Maze, the rows have no border columns, so nothing may
+        // carry from the first or last word of a row into the row before or after it. The layer is sorted by word, so
+        // a word two neighbors of the layer spread into is always among the last two added.
+        m_spread.clear();
+        auto spread = [this](std::uint64_t word, std::uint64_t cells) {
+            if (!m_spread.empty() && m_spread.back().first >= word)
+            {
+                ((m_spread.back().first == word) ? m_spread.back() : m_spread[m_spread.size() - 2]).second |= cells;
+                return;
+            }
+            m_spread.emplace_back(word, cells);
+        };
+        for (const auto &[word, cells] : m_layer)
+        {
+            const std::uint64_t wordInRow = word % m_row_words;
+            if (wordInRow > 0 && (cells << 63) != 0)
+            {
+                spread(word - 1, cells << 63);
+            }
+            spread(word, (cells << 1) | (cells >> 1));
+            if (wordInRow + 1 < m_row_words && (cells >> 63) != 0)
+            {
+                spread(word + 1, cells >> 63);
+            }
+        }
+
+        // Merge the spread with the layer moved a row up and a row down, all three sorted by word, and keep the open
+        // cells not reached yet
+        label = (label % 3) + 1;
+        m_next_layer.clear();
+        std::size_t up = 0;
+        std::size_t same = 0;
+        std::size_t down = 0;
+        while (up < m_layer.size() && m_layer[up].first < m_row_words)
+        {
+            ++up; // The first row has no row above it
+        }
+        while (true)
+        {
+            const std::uint64_t upWord = (up < m_layer.size()) ? m_layer[up].first - m_row_words : NO_WORD;
+            const std::uint64_t sameWord = (same < m_spread.size()) ? m_spread[same].first : NO_WORD;
+            const std::uint64_t downWord =
+                (down < m_layer.size() && m_layer[down].first + m_row_words < words) ? m_layer[down].first + m_row_words : NO_WORD;
+            const std::uint64_t word = std::min({upWord, sameWord, downWord});
+            if (word == NO_WORD)
+            {
+                break;
+            }
+            std::uint64_t cells = 0;
+            if (upWord == word)
+            {
+                cells |= m_layer[up++].second;
+            }
+            if (sameWord == word)
+            {
+                cells |= m_spread[same++].second;
+            }
+            if (downWord == word)
+            {
+                cells |= m_layer[down++].second;
+            }
+
+            std::uint64_t reached = cells & open[word] & ~(m_label_low[word] | m_label_high[word]);
+            if (word % m_row_words == m_row_words - 1)
+            {
+                reached &= lastWordMask; // The padding bits are 0 in a valid file, a corrupt one must not add cells
+            }
+            if (reached == 0)
+            {
+                continue;
+            }
+            if ((label & 1) != 0)
+            {
+                m_label_low[word] |= reached;
+            }
+            if ((label & 2) != 0)
+            {
+                m_label_high[word] |= reached;
+            }
+            m_next_layer.emplace_back(word, reached);
+            m_nodes_explored += countSetBits(reached);
+        }
+        m_layer.swap(m_next_layer);
+        found = ((m_label_low[endWord] | m_label_high[endWord]) & endMask) != 0;
+    }
+
+    if (found)
+    {
+        reconstructPath(label);
+    }
+    return m_path;
+}
+
+void MazeFileBFS::reconstructPath(int label)
+{
+    // Neighbors on a shortest path are exactly one layer apart, and of the three layers a reached neighbor can be in
+    // only the previous one has the previous label
+    const auto [startRow, startCol] = m_file.getStart();
+    auto [row, col] = m_file.getEnd();
+    m_path.emplace_back(row, col);
+    while (row != startRow || col != startCol)
+    {
+        const int previous = ((label + 1) % 3) + 1;
+        if (row > 0 && labelOf(row - 1, col) == previous)
+        {
+            --row;
+        }
+        else if (row + 1 < m_file.getHeight() && labelOf(row + 1, col) == previous)
+        {
+            ++row;
+        }
+        else if (col > 0 && labelOf(row, col - 1) == previous)
+        {
+            --col;
+        }
+        else
+        {
+            ++col;
+        }
+        label = previous;
+        m_path.emplace_back(row, col);
+    }
+}
+
+double streamEllerMaze(const std::string &path, std::uint64_t width, std::uint64_t height, unsigned int seed)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Same dimension rules as Maze: odd, so rooms are on odd coordinates and walls on even ones
+    width = std::max<std::uint64_t>(MIN_MAZE_DIMENSION, (width % 2 == 0) ? width + 1 : width);
+    height = std::max<std::uint64_t>(MIN_MAZE_DIMENSION, (height % 2 == 0) ? height + 1 : height);
+    const std::uint64_t roomColumns = (width - 1) / 2;
+    const std::uint64_t roomRows = (height - 1) / 2;
+    if (roomColumns > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::invalid_argument("Maze width " + std::to_string(width) + " has too many rooms per row");
+    }
+
+    std::mt19937 rng(resolveMazeSeed(seed));
+    EllerRowGenerator rows(static_cast<int>(roomColumns), rng);
+    MazeFileWriter writer(path, width, height, {1, 1}, {height - 2, width - 2});
+
+    // Two packed rows are all the maze state: the row of rooms and the wall row below it
+    const std::uint64_t rowWords = writer.getRowWords();
+    const std::uint64_t lastWordMask = (width % 64 == 0) ? ~0ull : ((1ull << (width % 64)) - 1);
+    std::vector<std::uint64_t> roomRow(rowWords);
+    std::vector<std::uint64_t> wallRow(rowWords, 0);
+    std::vector<std::uint8_t> rightOpen;
+    std::vector<std::uint8_t> downOpen;
+
+    // The top border row is all wall
+    writer.writeRow(wallRow.data());
+    for (std::uint64_t roomRowIndex = 0; roomRowIndex < roomRows; ++roomRowIndex)
+    {
+        rows.nextRow(roomRowIndex == roomRows - 1, rightOpen, downOpen);
+
+        // Room j is column 2j + 1, its right wall column 2j + 2 and its down wall column 2j + 1 of the next row.
+        // The last column is always an even border column, so the room pattern never opens it.
+        std::fill(roomRow.begin(), roomRow.end(), ROOM_BITS);
+        roomRow.back() &= lastWordMask;
+        std::fill(wallRow.begin(), wallRow.end(), 0);
+        for (std::uint64_t roomCol = 0; roomCol < roomColumns; ++roomCol)
+        {
+            const std::uint64_t col = (2 * roomCol) + 1;
+            if (roomCol + 1 < roomColumns && rightOpen[roomCol])
+            {
+                roomRow[(col + 1) / 64] |= 1ull << ((col + 1) % 64);
+            }
+            if (downOpen[roomCol])
+            {
+                wallRow[col / 64] |= 1ull << (col % 64);
+            }
+        }
+        writer.writeRow(roomRow.data());
+
+        // The last room row opens nothing downwards, so its wall row is the bottom border
+        writer.writeRow(wallRow.data());
+    }
+    writer.finish();
+
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    double cells = static_cast<double>(width) * static_cast<double>(height);
+    double throughput = (seconds > 0.0) ? cells / seconds : 0.0;
+    std::cout << "Streamed " << width << "x" << height << " maze with Eller to " << path << " in " << seconds * 1000.0 << " ms ("
+              << throughput << " cells/s)" << std::endl;
+    return throughput;
+}
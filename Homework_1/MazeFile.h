@@ -0,0 +1,273 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file MazeFile.h
+ * @brief Bit-packed binary maze files: a streaming writer, a memory-mapped reader and Eller's algorithm streamed to disk
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A maze file is a MazeFileHeader followed by getHeight() rows of bits, one bit per cell
+ * (1 = open, 0 = wall). Every row is padded to whole 64-bit words: bit (col % 64) of word
+ * (col / 64) holds column col and the padding bits are 0. The header is 64 bytes, so when the
+ * file is mapped into memory every row starts on an 8-byte boundary and can be read in place
+ * as an array of std::uint64_t. Values are stored in the byte order of the host that wrote them.
+ */
+
+#ifndef HOMEWORK_1_MAZEFILE_H_
+#define HOMEWORK_1_MAZEFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define MAZE_FILE_MAGIC "ECEMAZE1"
+#define MAZE_FILE_VERSION 1
+#define MAZE_FILE_BYTE_ORDER 0x01020304u // Read back as a different value on a host of the other byte order
+
+/**
+ * @struct MazeFileHeader
+ * @brief Fixed-size header at the start of every maze file
+ */
+struct MazeFileHeader
+{
+    char magic[8];           // MAZE_FILE_MAGIC without the terminating zero
+    std::uint32_t version;   // MAZE_FILE_VERSION
+    std::uint32_t byteOrder; // MAZE_FILE_BYTE_ORDER as written by the producing host
+    std::uint64_t width;     // Cells per row
+    std::uint64_t height;    // Number of rows
+    std::uint64_t startRow;
+    std::uint64_t startCol;
+    std::uint64_t endRow;
+    std::uint64_t endCol;
+};
+static_assert(sizeof(MazeFileHeader) == 64, "MazeFileHeader must keep the rows 8-byte aligned");
+
+/**
+ * @brief Get the number of 64-bit words stored per row
+ * @param width Cells per row
+ * @return Words per row
+ */
+inline std::uint64_t mazeFileRowWords(std::uint64_t width)
+{
+    return (width + 63) / 64;
+}
+
+/**
+ * @class MazeFileWriter
+ * @brief Writes a maze file one row at a time, so the maze never has to be held in memory
+ */
+class MazeFileWriter
+{
+  public:
+    /**
+     * @brief Create the file and write its header
+     * @param path File to create (an existing file is replaced)
+     * @param width Cells per row
+     * @param height Number of rows
+     * @param start Start position (row, col)
+     * @param end End position (row, col)
+     * @throws std::runtime_error if the file cannot be created
+     */
+    MazeFileWriter(const std::string &path, std::uint64_t width, std::uint64_t height, std::pair<std::uint64_t, std::uint64_t> start,
+                   std::pair<std::uint64_t, std::uint64_t> end);
+
+    /**
+     * @brief Append the next row
+     * @param bits getRowWords() words with one bit per cell, the padding bits must be 0
+     * @throws std::runtime_error if every row was already written or the write fails
+     */
+    void writeRow(const std::uint64_t *bits);
+
+    /**
+     * @brief Flush and close the file
+     * @throws std::runtime_error if fewer than height rows were written or the data cannot be flushed
+     */
+    void finish();
+
+    /**
+     * @brief Get the number of 64-bit words per row
+     */
+    std::uint64_t getRowWords() const
+    {
+        return m_row_words;
+    }
+
+  private:
+    std::string m_path;
+    std::vector<char> m_buffer; // Stream buffer, large enough to write whole rows with few system calls
+    std::ofstream m_out;
+    std::uint64_t m_row_words;
+    std::uint64_t m_height;
+    std::uint64_t m_rows_written;
+};
+
+/**
+ * @class MazeFile
+ * @brief Read-only, memory-mapped view of a maze file
+ *
+ * Opening a file maps it and validates the header; no cell data is read or copied until it is
+ * accessed, and the operating system pages rows in on demand. MazeFileBFS searches the packed
+ * rows in place, so a maze is solved without decoding it into a Maze.
+ */
+class MazeFile
+{
+  public:
+    /**
+     * @brief Map a maze file into memory
+     * @param path File to open
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid maze file
+     */
+    explicit MazeFile(const std::string &path);
+    ~MazeFile();
+
+    MazeFile(const MazeFile &) = delete;
+    MazeFile &operator=(const MazeFile &) = delete;
+
+    /**
+     * @brief Get maze dimensions
+     */
+    std::uint64_t getWidth() const
+    {
+        return m_header.width;
+    }
+    std::uint64_t getHeight() const
+    {
+        return m_header.height;
+    }
+
+    /**
+     * @brief Get start and end positions (row, col)
+     */
+    std::pair<std::uint64_t, std::uint64_t> getStart() const
+    {
+        return {m_header.startRow, m_header.startCol};
+    }
+    std::pair<std::uint64_t, std::uint64_t> getEnd() const
+    {
+        return {m_header.endRow, m_header.endCol};
+    }
+
+    /**
+     * @brief Get the number of 64-bit words per row
+     */
+    std::uint64_t getRowWords() const
+    {
+        return m_row_words;
+    }
+
+    /**
+     * @brief Get the packed bits of a row, pointing into the mapped file (no bounds check)
+     * @param row Row index
+     * @return getRowWords() words, bit (col % 64) of word (col / 64) is set when the cell is open
+     */
+    const std::uint64_t *getRow(std::uint64_t row) const
+    {
+        return m_rows + (row * m_row_words);
+    }
+
+    /**
+     * @brief Check if a cell is open (no bounds check)
+     * @param row Row index
+     * @param col Column index
+     * @return true if the cell can be traversed
+     */
+    bool isOpen(std::uint64_t row, std::uint64_t col) const
+    {
+        return ((getRow(row)[col / 64] >> (col % 64)) & 1u) != 0;
+    }
+
+  private:
+    const unsigned char *m_data; // Start of the mapping
+    std::size_t m_size;          // Length of the mapping in bytes
+    MazeFileHeader m_header;
+    const std::uint64_t *m_rows; // First row, directly after the header
+    std::uint64_t m_row_words;
+
+    /**
+     * @brief Release the mapping
+     */
+    void unmap();
+};
+
+/**
+ * @class MazeFileBFS
+ * @brief Breadth-first search over the mapped rows of a maze file, 64 cells per word
+ *
+ * The layers spread like BitboardBFS: a word of the layer reaches its shifts left and right, the
+ * cells crossing into the adjacent words of the same row and the same word of the rows above and
+ * below, masked with the open cells read from MazeFile::getRow(). The maze is never copied; the
+ * search keeps two bitmaps of its own holding the layer number of each reached cell modulo 3,
+ * plus one so that 0 means not reached, which is all the path needs (2 bits per cell, twice the
+ * size of the file's cell data). The layers are sorted lists of their non-empty words, so no
+ * bitmap has to be cleared between them.
+ */
+class MazeFileBFS
+{
+  public:
+    /**
+     * @brief Construct a solver for a mapped maze file
+     * @param file The maze file, which must outlive the solver
+     */
+    explicit MazeFileBFS(const MazeFile &file);
+
+    /**
+     * @brief Search from the start to the end of the file
+     * @return Positions (row, col) from end back to start (empty if the end cannot be reached), valid until the next search
+     */
+    const std::vector<std::pair<std::uint64_t, std::uint64_t>> &solveMaze();
+
+    /**
+     * @brief Get the number of cells reached by the last search, the start excluded
+     */
+    std::uint64_t getNodesExplored() const
+    {
+        return m_nodes_explored;
+    }
+
+  private:
+    const MazeFile &m_file;
+    std::uint64_t m_row_words;                                         // Words per row, as in the file
+    std::vector<std::uint64_t> m_label_low;                            // Bit 0 of the label of each cell, one row of words per row
+    std::vector<std::uint64_t> m_label_high;                           // Bit 1 of the label of each cell
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_layer;      // Word index and cells of the current layer, by word
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_spread;     // Cells the layer spreads into within its rows, by word
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_next_layer; // Cells of the layer being computed, by word
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_path;
+    std::uint64_t m_nodes_explored;
+
+    /**
+     * @brief Get the label of a cell: its layer number modulo 3 plus one, 0 if it was not reached
+     * @param row Row index
+     * @param col Column index
+     */
+    int labelOf(std::uint64_t row, std::uint64_t col) const;
+
+    /**
+     * @brief Walk the labels back from end to start into m_path
+     * @param label Label of the end
+     */
+    void reconstructPath(int label);
+};
+
+/**
+ * @brief Generate a perfect maze with Eller's algorithm and stream it to a maze file
+ *
+ * Only one row of set labels (EllerRowGenerator) and two packed rows are kept in memory, so
+ * mazes much larger than the available memory can be generated. The dimensions are adjusted
+ * like Maze (odd, at least 11) and the start and end are placed at the same corners.
+ * @param path File to create
+ * @param width Number of cells horizontally
+ * @param height Number of cells vertically
+ * @param seed Seed for the random number generator (0 = time-based)
+ * @return Generated cells per second
+ * @throws std::invalid_argument if a row has more rooms than an int can count
+ * @throws std::runtime_error if the file cannot be written
+ */
+double streamEllerMaze(const std::string &path, std::uint64_t width, std::uint64_t height, unsigned int seed = 0);
+
+#endif // HOMEWORK_1_MAZEFILE_H_
@@ -5,7 +5,7 @@
  * Description:  Homework 1: Maze Generator and Solver Visualization
  *
  * @file MazeGenerator.cpp
- * @brief Implementation of maze generation using recursive backtracking
+ * @brief Implementation of maze generation using recursive backtracking, Wilson's, Eller's and Kruskal's algorithms
  * @course ECE 4122/6122 - Homework 21
  *
  * The recursive backtracking algorithm works as follows:
@@ -20,20 +20,144 @@
  *    b. Else if stack is not empty:
  *       - Pop a cell from stack and make it current
  * 4. Algorithm terminates when stack is empty
+ * The stack is kept as one backtracking direction per room, so large mazes cannot overflow the call stack.
+ *
+ * Wilson's algorithm adds loop-erased random walks to the maze until every room is part of it, Eller's algorithm
+ * builds the maze row by row keeping only one row of set labels, and Kruskal's algorithm removes walls in random
+ * order whenever they separate two different trees (tracked with union-find). Any of them can be followed by knocking
+ * out a percentage of the remaining walls, which adds loops and open rooms.
  *
  * This file was provided as part of Homework 1 artifacts.  It has been slightly modified to extend it's functionality.
  */
 
 #include "MazeGenerator.h"
+#include "MazeFile.h"
 #include <SFML/Graphics.hpp>
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <chrono>
-#include <iostream>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 #define MAZE_OFFSET 10
 #define MIN_WINDOW_WIDTH 1000
 #define MIN_WINDOW_HEIGHT 600
+#define MIN_MAZE_DIMENSION 11
+#define TERRAIN_PATCH 8     // Side in cells of the square patches of generateTerrain()
+#define MAX_TERRAIN_TINT 16 // Terrain cost drawn in the full mud color, cheaper cells are blended toward white
+
+// Room-to-room directions: UP, DOWN, LEFT, RIGHT (the opposite of direction d is d ^ 1)
+static constexpr int NUM_ROOM_DIRECTIONS = 4;
+static constexpr int ROOM_DIRECTION_ROW[NUM_ROOM_DIRECTIONS] = {-1, 1, 0, 0};
+static constexpr int ROOM_DIRECTION_COL[NUM_ROOM_DIRECTIONS] = {0, 0, -1, 1};
+static constexpr std::uint8_t NO_BACKTRACK = 0xFF; // Backtracking marker of the starting room
+
+// @class KeyedPermutation
+// @brief Random bijection on [0, size) without storing it: a 4-round Feistel network over the smallest even bit width
+// that covers size. Results outside the range are encrypted again (cycle walking), which keeps the mapping a permutation.
+class KeyedPermutation
+{
+  public:
+    KeyedPermutation(std::uint64_t size, std::mt19937 &rng) : m_size(size)
+    {
+        int bits = 2;
+        while ((std::uint64_t{1} << bits) < size)
+        {
+            bits += 2;
+        }
+        m_halfBits = bits / 2;
+        m_halfMask = (std::uint64_t{1} << m_halfBits) - 1;
+        for (auto &key : m_keys)
+        {
+            key = (static_cast<std::uint64_t>(rng()) << 32) | rng();
+        }
+    }
+
+    std::uint64_t operator()(std::uint64_t value) const
+    {
+        do
+        {
+            value = encrypt(value);
+        } while (value >= m_size);
+        return value;
+    }
+
+  private:
+    std::uint64_t m_size;
+    int m_halfBits;
+    std::uint64_t m_halfMask;
+    std::array<std::uint64_t, 4> m_keys;
+
+    std::uint64_t encrypt(std::uint64_t value) const
+    {
+        std::uint64_t left = value >> m_halfBits;
+        std::uint64_t right = value & m_halfMask;
+        for (std::uint64_t key : m_keys)
+        {
+            std::uint64_t mixed = (right ^ key) * 0x9E3779B97F4A7C15ULL;
+            mixed ^= mixed >> 29;
+            std::uint64_t next = left ^ (mixed & m_halfMask);
+            left = right;
+            right = next;
+        }
+        return (left << m_halfBits) | right;
+    }
+};
+
+std::string generationAlgorithmName(GenerationAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case GenerationAlgorithm::RecursiveBacktracker:
+        return "Backtracker";
+    case GenerationAlgorithm::Wilson:
+        return "Wilson";
+    case GenerationAlgorithm::Eller:
+        return "Eller";
+    case GenerationAlgorithm::Kruskal:
+        return "Kruskal";
+    }
+    return "Unknown";
+}
+
+GenerationAlgorithm parseGenerationAlgorithm(const std::string &name)
+{
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "backtracker" || lower == "recursive-backtracker" || lower == "dfs")
+    {
+        return GenerationAlgorithm::RecursiveBacktracker;
+    }
+    if (lower == "wilson")
+    {
+        return GenerationAlgorithm::Wilson;
+    }
+    if (lower == "eller")
+    {
+        return GenerationAlgorithm::Eller;
+    }
+    if (lower == "kruskal")
+    {
+        return GenerationAlgorithm::Kruskal;
+    }
+    throw std::invalid_argument("Unknown maze generation algorithm: " + name + " (expected backtracker, wilson, eller or kruskal)");
+}
+
+unsigned int resolveMazeSeed(unsigned int seed)
+{
+    if (seed == 0)
+    {
+        // Use time-based seed if not provided
+        auto time_seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        return static_cast<unsigned int>(time_seed);
+    }
+    return seed;
+}
 
 sf::Color lerpColor(const sf::Color &a, const sf::Color &b, float t)
 {
@@ -48,55 +172,180 @@ Maze::Maze(int width, int height, unsigned int seed)
     m_width = (width % 2 == 0) ? width + 1 : width;
     m_height = (height % 2 == 0) ? height + 1 : height;
     m_cell_size = 20;
-
-    // Enforce minimum and maximum sizes
-    m_width = std::max(11, std::min(m_width, 101));
-    m_height = std::max(11, std::min(m_height, 101));
+    m_generation_seconds = 0.0;
+    m_generation_throughput = 0.0;
+    m_wall_removal_percent = 0;
+
+    // Enforce minimum size. There is no display-driven maximum: the only limit is that the padded grid
+    // must be indexable with an int
+    m_width = std::max(MIN_MAZE_DIMENSION, m_width);
+    m_height = std::max(MIN_MAZE_DIMENSION, m_height);
+    if ((static_cast<long long>(m_width) + 2) * (static_cast<long long>(m_height) + 2) > std::numeric_limits<int>::max())
+    {
+        throw std::invalid_argument("Maze dimensions " + std::to_string(m_width) + "x" + std::to_string(m_height) +
+                                    " exceed the largest grid that can be indexed");
+    }
+    m_stride = m_width + 2;
 
     // Seed random number generator
-    if (seed == 0)
+    m_rng.seed(resolveMazeSeed(seed));
+
+    initializeGrid();
+}
+
+Maze::Maze(const MazeFile &file, unsigned int seed)
+{
+    if ((file.getWidth() + 2) * (file.getHeight() + 2) > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
     {
-        // Use time-based seed if not provided
-        auto time_seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-        m_rng.seed(static_cast<unsigned int>(time_seed));
+        throw std::invalid_argument("Maze file dimensions " + std::to_string(file.getWidth()) + "x" + std::to_string(file.getHeight()) +
+                                    " exceed the largest grid that can be indexed");
     }
-    else
+    m_width = static_cast<int>(file.getWidth());
+    m_height = static_cast<int>(file.getHeight());
+    m_cell_size = 20;
+    m_generation_seconds = 0.0;
+    m_generation_throughput = 0.0;
+    m_wall_removal_percent = 0;
+    m_stride = m_width + 2;
+    m_rng.seed(resolveMazeSeed(seed));
+
+    initializeGrid();
+
+    // Walls are the common case, so skip whole words without open cells
+    const std::uint64_t rowWords = file.getRowWords();
+    for (int row = 0; row < m_height; ++row)
     {
-        m_rng.seed(seed);
+        const std::uint64_t *bits = file.getRow(row);
+        const int rowStart = cellIndex(row, 0);
+        for (std::uint64_t word = 0; word < rowWords; ++word)
+        {
+            if (bits[word] == 0)
+            {
+                continue;
+            }
+            const int firstCol = static_cast<int>(word * 64);
+            const int lastCol = std::min(firstCol + 64, m_width);
+            for (int col = firstCol; col < lastCol; ++col)
+            {
+                if ((bits[word] >> (col - firstCol)) & 1u)
+                {
+                    m_cells[rowStart + col] = CellType::Path;
+                }
+            }
+        }
     }
 
-    std::cout << "Initialized maze with dimensions: " << m_width << "x" << m_height << std::endl;
-
-    initializeGrid();
+    m_start = {static_cast<int>(file.getStart().first), static_cast<int>(file.getStart().second)};
+    m_end = {static_cast<int>(file.getEnd().first), static_cast<int>(file.getEnd().second)};
+    m_cells[cellIndex(m_start.first, m_start.second)] = CellType::Start;
+    m_cells[cellIndex(m_end.first, m_end.second)] = CellType::End;
 }
 
-void Maze::initializeGrid()
+void Maze::save(const std::string &path) const
 {
-    m_grid.resize(m_height);
+    MazeFileWriter writer(path, m_width, m_height, {m_start.first, m_start.second}, {m_end.first, m_end.second});
+    std::vector<std::uint64_t> bits(writer.getRowWords());
     for (int row = 0; row < m_height; ++row)
     {
-        m_grid[row].resize(m_width);
+        std::fill(bits.begin(), bits.end(), 0);
+        const int rowStart = cellIndex(row, 0);
         for (int col = 0; col < m_width; ++col)
         {
-            m_grid[row][col].type = CellType::Wall;
-            m_grid[row][col].visited = false;
-            m_grid[row][col].row = row;
-            m_grid[row][col].col = col;
+            if (m_cells[rowStart + col] != CellType::Wall)
+            {
+                bits[col / 64] |= 1ull << (col % 64);
+            }
+        }
+        writer.writeRow(bits.data());
+    }
+    writer.finish();
+}
+
+Maze::Maze(const Maze &other)
+    : m_width(other.m_width), m_height(other.m_height), m_cell_size(other.m_cell_size), m_stride(other.m_stride), m_cells(other.m_cells),
+      m_generation_seconds(other.m_generation_seconds), m_generation_throughput(other.m_generation_throughput),
+      m_wall_removal_percent(other.m_wall_removal_percent), m_costs(other.m_costs), m_start(other.m_start), m_end(other.m_end),
+      m_rng(other.m_rng)
+{
+    invalidateDrawing();
+}
+
+void Maze::uploadRows(int firstRow, int lastRow)
+{
+    if (firstRow <= lastRow)
+    {
+        m_texture->update(m_pixels.data() + static_cast<std::size_t>(firstRow) * m_width * 4, m_width, lastRow - firstRow + 1, 0,
+                          firstRow);
+    }
+}
+
+void Maze::setCellTypes(int index, const CellType *types, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (m_cells[index + i] != types[i])
+        {
+            m_cells[index + i] = types[i];
+            m_dirty_blocks[(index + i) >> DIRTY_BLOCK_SHIFT] = 1;
         }
     }
 }
 
-void Maze::generate()
+void Maze::takeChangedBlocks(std::vector<int> &blocks)
 {
+    blocks.clear();
+    for (int block = 0; block < static_cast<int>(m_dirty_blocks.size()); ++block)
+    {
+        if (m_dirty_blocks[block])
+        {
+            m_dirty_blocks[block] = 0;
+            blocks.push_back(block);
+        }
+    }
+}
+
+void Maze::initializeGrid()
+{
+    // One allocation for the maze plus its border, everything starts as a wall
+    m_cells.assign(static_cast<std::size_t>(m_stride) * (m_height + 2), CellType::Wall);
+    invalidateDrawing();
+}
+
+void Maze::generate(GenerationAlgorithm algorithm)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
     // Reset the grid
     initializeGrid();
 
-    // Start carving from position (1,1)
-    // We use odd coordinates for paths, even for walls
-    carvePassages(1, 1);
+    // We use odd coordinates for paths (rooms), even for walls
+    switch (algorithm)
+    {
+    case GenerationAlgorithm::RecursiveBacktracker:
+        // Start carving from position (1,1)
+        carvePassages(1, 1);
+        break;
+    case GenerationAlgorithm::Wilson:
+        generateWilson();
+        break;
+    case GenerationAlgorithm::Eller:
+        generateEller();
+        break;
+    case GenerationAlgorithm::Kruskal:
+        generateKruskal();
+        break;
+    }
+    if (m_wall_removal_percent > 0)
+    {
+        removeWalls();
+    }
 
     // Place start and end positions
     placeStartAndEnd();
+
+    m_generation_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    double cells = static_cast<double>(m_width) * m_height;
+    m_generation_throughput = (m_generation_seconds > 0.0) ? cells / m_generation_seconds : 0.0;
 }
 
 void Maze::calculateWindowSize(int &window_width, int &window_height)
@@ -112,7 +361,7 @@ void Maze::calculateAdjustedWindowAndCellSize(int &window_width, int &window_hei
     float heightRatio = ((window_height - (2 * MAZE_OFFSET)) / m_height);
     float widthRatio = ((window_width - (2 * MAZE_OFFSET)) / m_width);
     float cell_size = std::min(widthRatio, heightRatio);
-    m_cell_size = static_cast<int>(cell_size);
+    m_cell_size = std::max(1, static_cast<int>(cell_size)); // Very large mazes draw one pixel per cell
 
     // Recalculate window size based on new cell size
     calculateWindowSize(window_width, window_height);
@@ -156,174 +405,540 @@ void Maze::getWindowSize(int &window_width, int &window_height, int desktopWidth
 
 void Maze::draw(sf::RenderWindow &window)
 {
-    // offset values
-    int offsetX = MAZE_OFFSET;
-    int offsetY = MAZE_OFFSET;
-    int cellSize = m_cell_size;
+    // Fill colors of the cell types, in the order of CellType
+    static const sf::Color cellColors[] = {
+        sf::Color(50, 50, 50),                                                // Wall: DarkGray
+        sf::Color(255, 255, 255),                                             // Path: White
+        sf::Color(0, 200, 0),                                                 // Start: Green
+        sf::Color(200, 0, 0),                                                 // End: Red
+        lerpColor(sf::Color(255, 255, 255), sf::Color(173, 216, 230), 0.5f), // Visited: White to LightBlue
+        lerpColor(sf::Color(173, 216, 230), sf::Color(255, 255, 0), 0.5f)    // Solution: LightBlue to Yellow
+    };
+
+    if (!m_texture || m_texture->getSize() != sf::Vector2u(m_width, m_height))
+    {
+        m_texture = std::make_unique<sf::Texture>();
+        m_texture->create(m_width, m_height);
+        m_pixels.resize(static_cast<std::size_t>(m_width) * m_height * 4);
+        invalidateDrawing();
+    }
+
+    // Recolor the cells of every changed block and upload the rows they lie in, consecutive rows in one update. Far apart
+    // changes, like the two ends of a bidirectional search, upload only their own rows. The border is never drawn.
+    const int cellCount = static_cast<int>(m_cells.size());
+    int runFirst = 0;
+    int runLast = -1;
+    for (int block = 0; block < static_cast<int>(m_dirty_blocks.size()); ++block)
+    {
+        if (!m_dirty_blocks[block])
+        {
+            continue;
+        }
+        m_dirty_blocks[block] = 0;
+        const int first = block << DIRTY_BLOCK_SHIFT;
+        const int last = std::min(first + (1 << DIRTY_BLOCK_SHIFT), cellCount) - 1;
+        int row = rowOf(first);
+        int col = colOf(first);
+        for (int index = first; index <= last; ++index)
+        {
+            if (row >= 0 && row < m_height && col >= 0 && col < m_width)
+            {
+                sf::Color color = cellColors[static_cast<int>(m_cells[index])];
+                if (!m_costs.empty() && m_cells[index] == CellType::Path)
+                {
+                    // Open terrain is tinted from white toward brown mud by its cost
+                    const int cost = std::min(static_cast<int>(m_costs[index]), MAX_TERRAIN_TINT);
+                    color = lerpColor(color, sf::Color(150, 110, 60), static_cast<float>(cost - 1) / (MAX_TERRAIN_TINT - 1));
+                }
+                sf::Uint8 *pixel = m_pixels.data() + (static_cast<std::size_t>(row) * m_width + col) * 4;
+                pixel[0] = color.r;
+                pixel[1] = color.g;
+                pixel[2] = color.b;
+                pixel[3] = color.a;
+            }
+            if (++col == m_width + 1)
+            {
+                col = -1;
+                ++row;
+            }
+        }
+
+        const int firstRow = std::max(0, rowOf(first));
+        const int lastRow = std::min(m_height - 1, rowOf(last));
+        if (firstRow > lastRow)
+        {
+            continue; // Only border cells
+        }
+        if (firstRow > runLast + 1)
+        {
+            uploadRows(runFirst, runLast);
+            runFirst = firstRow;
+        }
+        runLast = std::max(runLast, lastRow);
+    }
+    uploadRows(runFirst, runLast);
 
-    // Create rectangle shape once and reuse for all cells
-    sf::RectangleShape cellShape(sf::Vector2f(cellSize, cellSize));
+    sf::Sprite cells(*m_texture);
+    cells.setPosition(MAZE_OFFSET, MAZE_OFFSET);
+    cells.setScale(static_cast<float>(m_cell_size), static_cast<float>(m_cell_size));
+    window.draw(cells);
 
-    for (int y = 0; y < m_height; ++y)
+    // Grid lines between cells, as the DarkGray cell outlines used to draw; cells of one or two pixels have no room for them
+    if (m_cell_size < 3)
+    {
+        return;
+    }
+    const unsigned int cellSize = static_cast<unsigned int>(m_cell_size);
+    if (!m_outline_texture || m_outline_texture->getSize().x != cellSize)
     {
-        for (int x = 0; x < m_width; ++x)
+        sf::Image outline;
+        outline.create(cellSize, cellSize, sf::Color::Transparent);
+        for (unsigned int i = 0; i < cellSize; ++i)
         {
-            const Cell &cell = m_grid[y][x];
+            outline.setPixel(cellSize - 1, i, cellColors[static_cast<int>(CellType::Wall)]);
+            outline.setPixel(i, cellSize - 1, cellColors[static_cast<int>(CellType::Wall)]);
+        }
+        m_outline_texture = std::make_unique<sf::Texture>();
+        m_outline_texture->loadFromImage(outline);
+        m_outline_texture->setRepeated(true);
+    }
+    sf::Sprite outlines(*m_outline_texture, sf::IntRect(0, 0, m_width * m_cell_size, m_height * m_cell_size));
+    outlines.setPosition(MAZE_OFFSET, MAZE_OFFSET);
+    window.draw(outlines);
+}
+
+int Maze::roomCellIndex(int room) const
+{
+    const int roomColumns = (m_width - 1) / 2;
+    return cellIndex((2 * (room / roomColumns)) + 1, (2 * (room % roomColumns)) + 1);
+}
+
+void Maze::connectRooms(int roomA, int roomB)
+{
+    int cellA = roomCellIndex(roomA);
+    int cellB = roomCellIndex(roomB);
+
+    // The wall between two adjacent rooms sits halfway between them in the flat grid
+    m_cells[cellA] = CellType::Path;
+    m_cells[(cellA + cellB) / 2] = CellType::Path;
+    m_cells[cellB] = CellType::Path;
+}
+
+void Maze::carvePassages(int row, int col)
+{
+    const int roomColumns = (m_width - 1) / 2;
+    const int roomRows = (m_height - 1) / 2;
+
+    // Direction back to the room each room was entered from; this replaces the recursion stack
+    std::vector<std::uint8_t> backtrack(static_cast<std::size_t>(roomColumns) * roomRows, NO_BACKTRACK);
 
-            // Draw rectangles for walls based on cell.walls booleans
-            float left = offsetX + x * cellSize;
-            float top = offsetY + y * cellSize;
-            // Update position for this cell
-            cellShape.setPosition(left, top);
+    // Carve out the starting cell, which also marks it as visited
+    int roomRow = (row - 1) / 2;
+    int roomCol = (col - 1) / 2;
+    m_cells[cellIndex(row, col)] = CellType::Path;
 
-            switch (cell.type)
+    int candidates[NUM_ROOM_DIRECTIONS];
+    while (true)
+    {
+        // Get all unvisited neighbors (rooms 2 cells away that are still walls)
+        int count = 0;
+        for (int dir = 0; dir < NUM_ROOM_DIRECTIONS; ++dir)
+        {
+            int nRow = roomRow + ROOM_DIRECTION_ROW[dir];
+            int nCol = roomCol + ROOM_DIRECTION_COL[dir];
+            if (nRow >= 0 && nRow < roomRows && nCol >= 0 && nCol < roomColumns &&
+                m_cells[cellIndex((2 * nRow) + 1, (2 * nCol) + 1)] == CellType::Wall)
             {
-            case CellType::Wall: {
-                cellShape.setFillColor(sf::Color(50, 50, 50)); // DarkGray
-                break;
-            }
-            case CellType::Path: {
-                cellShape.setOutlineThickness(1.f);
-                cellShape.setOutlineColor(sf::Color(50, 50, 50)); // DarkGray border
-                cellShape.setFillColor(sf::Color(255, 255, 255));
-                break;
+                candidates[count++] = dir;
             }
-            case CellType::Visited: {
-                cellShape.setOutlineThickness(1.f);
-                cellShape.setOutlineColor(sf::Color(50, 50, 50)); // DarkGray border
-                cellShape.setFillColor(lerpColor(sf::Color(255, 255, 255), sf::Color(173, 216, 230),
-                                                 0.5f)); // White to LightBlue for visited
-                break;
-            }
-            case CellType::Start: {
-                cellShape.setOutlineThickness(1.f);
-                cellShape.setOutlineColor(sf::Color(50, 50, 50)); // DarkGray border
-                cellShape.setFillColor(sf::Color(0, 200, 0));     // Green
+        }
+
+        if (count > 0)
+        {
+            // Carve through the wall to a random unvisited neighbor and continue from there
+            int dir = candidates[std::uniform_int_distribution<int>(0, count - 1)(m_rng)];
+            int nRow = roomRow + ROOM_DIRECTION_ROW[dir];
+            int nCol = roomCol + ROOM_DIRECTION_COL[dir];
+            connectRooms((roomRow * roomColumns) + roomCol, (nRow * roomColumns) + nCol);
+            backtrack[(static_cast<std::size_t>(nRow) * roomColumns) + nCol] = static_cast<std::uint8_t>(dir ^ 1);
+            roomRow = nRow;
+            roomCol = nCol;
+        }
+        else
+        {
+            // Dead end: step back the way we came, or stop once the starting room is exhausted
+            std::uint8_t back = backtrack[(static_cast<std::size_t>(roomRow) * roomColumns) + roomCol];
+            if (back == NO_BACKTRACK)
+            {
                 break;
             }
-            case CellType::End: {
-                cellShape.setOutlineThickness(1.f);
-                cellShape.setOutlineColor(sf::Color(50, 50, 50)); // DarkGray border
-                cellShape.setFillColor(sf::Color(200, 0, 0));     // Red
+            roomRow += ROOM_DIRECTION_ROW[back];
+            roomCol += ROOM_DIRECTION_COL[back];
+        }
+    }
+}
+
+void Maze::generateWilson()
+{
+    const int roomColumns = (m_width - 1) / 2;
+    const int roomRows = (m_height - 1) / 2;
+    const int roomCount = roomColumns * roomRows;
+
+    // Last direction taken out of each room during the current walk; overwriting it erases loops
+    std::vector<std::uint8_t> exitDirection(roomCount, 0);
+    std::uniform_int_distribution<int> pickDirection(0, NUM_ROOM_DIRECTIONS - 1);
+
+    // The maze starts as a single random room
+    m_cells[roomCellIndex(std::uniform_int_distribution<int>(0, roomCount - 1)(m_rng))] = CellType::Path;
+
+    for (int first = 0; first < roomCount; ++first)
+    {
+        if (m_cells[roomCellIndex(first)] != CellType::Wall)
+        {
+            continue; // Already part of the maze
+        }
+
+        // Random walk from this room until it hits the maze
+        int room = first;
+        while (m_cells[roomCellIndex(room)] == CellType::Wall)
+        {
+            int roomRow = room / roomColumns;
+            int roomCol = room % roomColumns;
+            int dir = 0;
+            int nRow = 0;
+            int nCol = 0;
+            do
+            {
+                dir = pickDirection(m_rng);
+                nRow = roomRow + ROOM_DIRECTION_ROW[dir];
+                nCol = roomCol + ROOM_DIRECTION_COL[dir];
+            } while (nRow < 0 || nRow >= roomRows || nCol < 0 || nCol >= roomColumns);
+
+            exitDirection[room] = static_cast<std::uint8_t>(dir);
+            room = (nRow * roomColumns) + nCol;
+        }
+
+        // Follow the last exits from the first room: this is the walk with its loops erased
+        room = first;
+        while (true)
+        {
+            int dir = exitDirection[room];
+            int next = room + (ROOM_DIRECTION_ROW[dir] * roomColumns) + ROOM_DIRECTION_COL[dir];
+            bool reachedMaze = m_cells[roomCellIndex(next)] != CellType::Wall;
+            connectRooms(room, next);
+            if (reachedMaze)
+            {
                 break;
             }
-            case CellType::Solution: {
-                cellShape.setOutlineThickness(1.f);
-                cellShape.setOutlineColor(sf::Color(50, 50, 50)); // DarkGray border
-                cellShape.setFillColor(lerpColor(sf::Color(173, 216, 230), sf::Color(255, 255, 0),
-                                                 0.5f)); // LightBlue to Yellow for solution
-                break;
+            room = next;
+        }
+    }
+}
+
+void Maze::generateEller()
+{
+    const int roomColumns = (m_width - 1) / 2;
+    const int roomRows = (m_height - 1) / 2;
+
+    EllerRowGenerator rows(roomColumns, m_rng);
+    std::vector<std::uint8_t> rightOpen;
+    std::vector<std::uint8_t> downOpen;
+    for (int roomRow = 0; roomRow < roomRows; ++roomRow)
+    {
+        rows.nextRow(roomRow == roomRows - 1, rightOpen, downOpen);
+
+        // Rooms are every other cell of the row; walls to the right are +1 and walls below are +stride
+        int cell = cellIndex((2 * roomRow) + 1, 1);
+        for (int roomCol = 0; roomCol < roomColumns; ++roomCol, cell += 2)
+        {
+            m_cells[cell] = CellType::Path;
+            if (roomCol < roomColumns - 1 && rightOpen[roomCol])
+            {
+                m_cells[cell + 1] = CellType::Path;
             }
+            if (downOpen[roomCol])
+            {
+                m_cells[cell + m_stride] = CellType::Path;
             }
-            window.draw(cellShape);
         }
     }
 }
 
-void Maze::carvePassages(int row, int col)
+void Maze::generateKruskal()
+{
+    const int roomColumns = (m_width - 1) / 2;
+    const int roomRows = (m_height - 1) / 2;
+    const int roomCount = roomColumns * roomRows;
+
+    // Every room starts as its own tree
+    std::vector<int> parent(roomCount);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int room) {
+        while (parent[room] != room)
+        {
+            parent[room] = parent[parent[room]]; // Path halving
+            room = parent[room];
+        }
+        return room;
+    };
+
+    // Walls between rooms are numbered: the ones between horizontal neighbours first, then the vertical ones
+    const std::uint64_t horizontalWalls = static_cast<std::uint64_t>(roomRows) * (roomColumns - 1);
+    const std::uint64_t wallCount = horizontalWalls + (static_cast<std::uint64_t>(roomRows - 1) * roomColumns);
+    KeyedPermutation order(wallCount, m_rng);
+
+    // A spanning tree has roomCount - 1 passages, so stop as soon as all of them are carved
+    int joined = 0;
+    for (std::uint64_t i = 0; i < wallCount && joined < roomCount - 1; ++i)
+    {
+        std::uint64_t wall = order(i);
+        int roomA = 0;
+        int roomB = 0;
+        if (wall < horizontalWalls)
+        {
+            roomA = static_cast<int>(((wall / (roomColumns - 1)) * roomColumns) + (wall % (roomColumns - 1)));
+            roomB = roomA + 1;
+        }
+        else
+        {
+            roomA = static_cast<int>(wall - horizontalWalls);
+            roomB = roomA + roomColumns;
+        }
+
+        int rootA = findRoot(roomA);
+        int rootB = findRoot(roomB);
+        if (rootA != rootB)
+        {
+            parent[rootB] = rootA;
+            connectRooms(roomA, roomB);
+            ++joined;
+        }
+    }
+}
+
+EllerRowGenerator::EllerRowGenerator(int roomColumns, std::mt19937 &rng)
+    : m_columns(roomColumns), m_rng(rng), m_set(roomColumns), m_parent(roomColumns), m_members(roomColumns), m_hasDown(roomColumns),
+      m_inUse(roomColumns)
+{
+    // The first row starts with every room in its own set
+    std::iota(m_set.begin(), m_set.end(), 0);
+}
+
+int EllerRowGenerator::findSet(int label)
 {
-    // Mark current cell as visited and carve it out
-    m_grid[row][col].visited = true;
-    m_grid[row][col].type = CellType::Path;
+    while (m_parent[label] != label)
+    {
+        m_parent[label] = m_parent[m_parent[label]]; // Path halving
+        label = m_parent[label];
+    }
+    return label;
+}
 
-    // Get all unvisited neighbors (2 cells away to maintain wall structure)
-    std::vector<std::pair<int, int>> neighbors = getUnvisitedNeighbors(row, col);
+void EllerRowGenerator::nextRow(bool lastRow, std::vector<std::uint8_t> &rightOpen, std::vector<std::uint8_t> &downOpen)
+{
+    rightOpen.assign(std::max(m_columns - 1, 0), 0);
+    downOpen.assign(m_columns, 0);
+    std::iota(m_parent.begin(), m_parent.end(), 0);
+    std::bernoulli_distribution coin(0.5);
 
-    // Shuffle neighbors for randomness
-    std::shuffle(neighbors.begin(), neighbors.end(), m_rng);
+    // Randomly join adjacent rooms of different sets; the last row joins all of them so the maze is connected
+    for (int col = 0; col + 1 < m_columns; ++col)
+    {
+        int left = findSet(m_set[col]);
+        int right = findSet(m_set[col + 1]);
+        if (left != right && (lastRow || coin(m_rng)))
+        {
+            rightOpen[col] = 1;
+            m_parent[right] = left;
+        }
+    }
+    for (int col = 0; col < m_columns; ++col)
+    {
+        m_set[col] = findSet(m_set[col]);
+    }
+    if (lastRow)
+    {
+        return;
+    }
 
-    // Visit each neighbor
-    for (const auto &neighbor : neighbors)
+    // Every set must continue downwards at least once, otherwise it would be cut off from the rest of the maze
+    std::fill(m_members.begin(), m_members.end(), 0);
+    std::fill(m_hasDown.begin(), m_hasDown.end(), 0);
+    for (int col = 0; col < m_columns; ++col)
     {
-        int nRow = neighbor.first;
-        int nCol = neighbor.second;
+        ++m_members[m_set[col]];
+    }
+    for (int col = 0; col < m_columns; ++col)
+    {
+        int label = m_set[col];
+        --m_members[label];
+        if (coin(m_rng) || (m_members[label] == 0 && !m_hasDown[label]))
+        {
+            downOpen[col] = 1;
+            m_hasDown[label] = 1;
+        }
+    }
 
-        // Check if still unvisited (may have been visited via different path)
-        if (!m_grid[nRow][nCol].visited)
+    // Rooms below an opening stay in their set, the others start new sets with labels nobody uses
+    std::fill(m_inUse.begin(), m_inUse.end(), 0);
+    for (int col = 0; col < m_columns; ++col)
+    {
+        if (downOpen[col])
+        {
+            m_inUse[m_set[col]] = 1;
+        }
+    }
+    int freeLabel = 0;
+    for (int col = 0; col < m_columns; ++col)
+    {
+        if (!downOpen[col])
         {
-            // Carve through the wall between current and neighbor
-            int wallRow = row + (nRow - row) / 2;
-            int wallCol = col + (nCol - col) / 2;
-            m_grid[wallRow][wallCol].type = CellType::Path;
+            while (m_inUse[freeLabel])
+            {
+                ++freeLabel;
+            }
+            m_set[col] = freeLabel;
+            m_inUse[freeLabel] = 1;
+        }
+    }
+}
 
-            // Recursively carve from neighbor
-            carvePassages(nRow, nCol);
+void Maze::setWallRemovalPercent(int percent)
+{
+    if (percent < 0 || percent > 100)
+    {
+        throw std::invalid_argument("Wall removal percentage " + std::to_string(percent) + " is not between 0 and 100");
+    }
+    m_wall_removal_percent = percent;
+}
+
+void Maze::generateTerrain(int maxCost)
+{
+    if (maxCost < 1 || maxCost > 255)
+    {
+        throw std::invalid_argument("Terrain cost " + std::to_string(maxCost) + " is not between 1 and 255");
+    }
+
+    // One random cost per patch; the border keeps cost 1, solvers never enter it
+    const int patchCols = (m_width + TERRAIN_PATCH - 1) / TERRAIN_PATCH;
+    const int patchRows = (m_height + TERRAIN_PATCH - 1) / TERRAIN_PATCH;
+    std::uniform_int_distribution<int> cost(1, maxCost);
+    std::vector<std::uint8_t> patches(static_cast<std::size_t>(patchRows) * patchCols);
+    for (std::uint8_t &patch : patches)
+    {
+        patch = static_cast<std::uint8_t>(cost(m_rng));
+    }
+    m_costs.assign(m_cells.size(), 1);
+    for (int row = 0; row < m_height; ++row)
+    {
+        const std::uint8_t *patchRow = patches.data() + static_cast<std::size_t>(row / TERRAIN_PATCH) * patchCols;
+        std::uint8_t *costs = m_costs.data() + cellIndex(row, 0);
+        for (int col = 0; col < m_width; ++col)
+        {
+            costs[col] = patchRow[col / TERRAIN_PATCH];
         }
     }
+    invalidateDrawing();
 }
 
-std::vector<std::pair<int, int>> Maze::getUnvisitedNeighbors(int row, int col)
+void Maze::setCost(int row, int col, int cost)
 {
-    std::vector<std::pair<int, int>> neighbors;
+    if (cost < 1 || cost > 255)
+    {
+        throw std::invalid_argument("Terrain cost " + std::to_string(cost) + " is not between 1 and 255");
+    }
+    if (!isInBounds(row, col))
+    {
+        return;
+    }
+    if (m_costs.empty())
+    {
+        m_costs.assign(m_cells.size(), 1);
+    }
+    const int index = cellIndex(row, col);
+    m_costs[index] = static_cast<std::uint8_t>(cost);
+    m_dirty_blocks[index >> DIRTY_BLOCK_SHIFT] = 1;
+}
 
-    // Check all four directions (2 cells away for wall structure)
-    // Direction: {row_delta, col_delta}
-    const int directions[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
+void Maze::clearTerrain()
+{
+    m_costs.clear();
+    m_costs.shrink_to_fit();
+    invalidateDrawing();
+}
 
-    for (const auto *dir : directions)
+int Maze::getMinCost() const
+{
+    if (m_costs.empty())
+    {
+        return 1;
+    }
+    int minCost = 255;
+    for (int row = 0; row < m_height && minCost > 1; ++row)
     {
-        int newRow = row + dir[0];
-        int newCol = col + dir[1];
+        const std::uint8_t *costs = m_costs.data() + cellIndex(row, 0);
+        minCost = std::min(minCost, static_cast<int>(*std::min_element(costs, costs + m_width)));
+    }
+    return minCost;
+}
 
-        // Check bounds (staying within the border walls)
-        if (newRow > 0 && newRow < m_height - 1 && newCol > 0 && newCol < m_width - 1)
+void Maze::removeWalls()
+{
+    // Both wall cells between rooms (loops) and the corner cells between four rooms (open rooms) can go; the outer
+    // border stays so the maze keeps its frame
+    std::uniform_int_distribution<int> percentile(0, 99);
+    for (int row = 1; row < m_height - 1; ++row)
+    {
+        for (int index = cellIndex(row, 1); index <= cellIndex(row, m_width - 2); ++index)
         {
-            if (!m_grid[newRow][newCol].visited)
+            if (m_cells[index] == CellType::Wall && percentile(m_rng) < m_wall_removal_percent)
             {
-                // Valid unvisited neighbor
-                neighbors.push_back({newRow, newCol});
+                m_cells[index] = CellType::Path;
             }
         }
     }
-
-    return neighbors;
 }
 
 void Maze::placeStartAndEnd()
 {
     // Place start in top-left area
     m_start = {1, 1};
-    m_grid[m_start.first][m_start.second].type = CellType::Start;
+    m_cells[cellIndex(m_start.first, m_start.second)] = CellType::Start;
 
     // Place end in bottom-right area
     m_end = {m_height - 2, m_width - 2};
-    m_grid[m_end.first][m_end.second].type = CellType::End;
+    m_cells[cellIndex(m_end.first, m_end.second)] = CellType::End;
 }
 
 void Maze::resetVisualization()
 {
-    for (int row = 0; row < m_height; ++row)
+    // Single linear pass over the grid; the border is all walls and is left untouched. Only the blocks holding a cleared
+    // cell are redrawn, so resetting after a small search costs little more than the pass itself.
+    const int cellCount = static_cast<int>(m_cells.size());
+    for (int index = 0; index < cellCount; ++index)
     {
-        for (int col = 0; col < m_width; ++col)
+        if (m_cells[index] == CellType::Visited || m_cells[index] == CellType::Solution)
         {
-            CellType type = m_grid[row][col].type;
-            if (type == CellType::Visited || type == CellType::Solution)
-            {
-                m_grid[row][col].type = CellType::Path;
-            }
+            m_cells[index] = CellType::Path;
+            m_dirty_blocks[index >> DIRTY_BLOCK_SHIFT] = 1;
         }
     }
 
     // Restore start and end markers
-    m_grid[m_start.first][m_start.second].type = CellType::Start;
-    m_grid[m_end.first][m_end.second].type = CellType::End;
+    setCellType(cellIndex(m_start.first, m_start.second), CellType::Start);
+    setCellType(cellIndex(m_end.first, m_end.second), CellType::End);
 }
 
-Cell &Maze::getCell(int row, int col)
+CellType Maze::getCellType(int row, int col) const
 {
-    return m_grid[row][col];
-}
-
-const Cell &Maze::getCell(int row, int col) const
-{
-    return m_grid[row][col];
+    return m_cells[cellIndex(row, col)];
 }
 
 void Maze::setCellType(int row, int col, CellType type)
 {
     if (isInBounds(row, col))
     {
-        m_grid[row][col].type = type;
+        setCellType(cellIndex(row, col), type);
     }
 }
 
@@ -332,13 +947,20 @@ bool Maze::isInBounds(int row, int col) const
     return row >= 0 && row < m_height && col >= 0 && col < m_width;
 }
 
-bool Maze::isValidPath(int row, int col) const
+bool Maze::cellAt(int x, int y, int &row, int &col) const
 {
-    if (!isInBounds(row, col))
+    // Same layout as draw(): cells of m_cell_size pixels after a margin of MAZE_OFFSET
+    if (x < MAZE_OFFSET || y < MAZE_OFFSET)
     {
         return false;
     }
+    row = (y - MAZE_OFFSET) / m_cell_size;
+    col = (x - MAZE_OFFSET) / m_cell_size;
+    return isInBounds(row, col);
+}
 
-    CellType type = m_grid[row][col].type;
-    return type != CellType::Wall;
+bool Maze::isValidPath(int row, int col) const
+{
+    // No bounds check: one step outside the maze lands on the wall border
+    return m_cells[cellIndex(row, col)] != CellType::Wall;
 }
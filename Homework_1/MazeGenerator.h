@@ -5,11 +5,12 @@
  * Description:  Homework 1: Maze Generator and Solver Visualization
  *
  * @file MazeGenerator.h
- * @brief Maze generation using recursive backtracking algorithm
+ * @brief Maze generation using recursive backtracking, Wilson's, Eller's and Kruskal's algorithms
  * @course ECE 4122/6122 - Homework 1
  *
  * This header defines the Maze class which generates random, solvable mazes
- * using the recursive backtracking algorithm.
+ * using the recursive backtracking algorithm or one of the alternative generators,
+ * and the EllerRowGenerator that produces a maze one row at a time.
  *
  * This file was provided as part of Homework 1 artifacts.
  */
@@ -18,16 +19,23 @@
 #define HOMEWORK_1_MAZEGENERATOR_H_
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <random>
 #include <stack>
+#include <string>
 #include <utility>
 #include <vector>
 
+class MazeFile;
+
 /**
  * @enum CellType
- * @brief Enumeration of possible cell states in the maze
+ * @brief Enumeration of possible cell states in the maze, stored as one byte per cell
  */
-enum class CellType
+enum class CellType : std::uint8_t
 {
     Wall,    ///< Impassable wall
     Path,    ///< Open path that can be traversed
@@ -38,18 +46,75 @@ enum class CellType
 };
 
 /**
- * @struct Cell
- * @brief Represents a single cell in the maze grid
+ * @enum GenerationAlgorithm
+ * @brief Maze generation algorithms. All of them produce perfect mazes (exactly one path between any two cells).
  */
-struct Cell
+enum class GenerationAlgorithm
 {
-    CellType type;
-    bool visited; // Used during maze generation
-    int row, col;
+    RecursiveBacktracker, ///< Depth-first carving with an explicit backtracking trail (long, winding corridors)
+    Wilson,               ///< Loop-erased random walks (uniform spanning tree, unbiased)
+    Eller,                ///< Row-by-row set merging, only one row of state
+    Kruskal               ///< Random wall removal with union-find
+};
 
-    Cell() : type(CellType::Wall), visited(false), row(0), col(0)
-    {
-    }
+/**
+ * @brief Get the display name of a generation algorithm
+ * @param algorithm The algorithm
+ * @return Name such as "Eller"
+ */
+std::string generationAlgorithmName(GenerationAlgorithm algorithm);
+
+/**
+ * @brief Parse a generation algorithm name (case-insensitive: backtracker, wilson, eller, kruskal)
+ * @param name The name to parse
+ * @return The matching algorithm
+ * @throws std::invalid_argument if the name is unknown
+ */
+GenerationAlgorithm parseGenerationAlgorithm(const std::string &name);
+
+/**
+ * @brief Resolve the seed of a maze random number generator
+ * @param seed Requested seed (0 = time-based)
+ * @return The seed to use
+ */
+unsigned int resolveMazeSeed(unsigned int seed);
+
+/**
+ * @class EllerRowGenerator
+ * @brief Generates a perfect maze one row of rooms at a time with Eller's algorithm
+ *
+ * Rooms are the odd (row, col) cells of a maze; a maze of width W has (W - 1) / 2 room
+ * columns. The generator only keeps the set membership of the current row, so its memory
+ * does not depend on the number of rows and the rows can be consumed as they are produced.
+ */
+class EllerRowGenerator
+{
+  public:
+    /**
+     * @brief Construct a generator for rows of roomColumns rooms
+     * @param roomColumns Number of rooms per row (at least 1)
+     * @param rng Random number generator used for all decisions
+     */
+    EllerRowGenerator(int roomColumns, std::mt19937 &rng);
+
+    /**
+     * @brief Generate the next row of rooms
+     * @param lastRow true for the final row, which joins every remaining set and opens nothing downwards
+     * @param rightOpen Receives roomColumns - 1 flags, rightOpen[j] set when rooms j and j + 1 are connected
+     * @param downOpen Receives roomColumns flags, downOpen[j] set when room j connects to the room below
+     */
+    void nextRow(bool lastRow, std::vector<std::uint8_t> &rightOpen, std::vector<std::uint8_t> &downOpen);
+
+  private:
+    int m_columns;
+    std::mt19937 &m_rng;
+    std::vector<int> m_set;              // Set label of each room in the current row, labels are < m_columns
+    std::vector<int> m_parent;           // Union-find over labels while merging the current row
+    std::vector<int> m_members;          // Rooms per label not yet given a chance to open downwards
+    std::vector<std::uint8_t> m_hasDown; // Whether a label already opened downwards
+    std::vector<std::uint8_t> m_inUse;   // Labels carried into the next row
+
+    int findSet(int label);
 };
 
 /**
@@ -59,25 +124,134 @@ struct Cell
  * The maze is represented as a 2D grid where each cell can be either
  * a wall or a path. The generation algorithm ensures there is always
  * a valid path from start to end.
+ *
+ * The grid is one contiguous row-major array of CellType surrounded by a one-cell
+ * wall border that is never carved. Cell (row, col) lives at
+ * (row + 1) * getStride() + (col + 1), so the four neighbours of any maze cell are
+ * index - getStride(), index + getStride(), index - 1 and index + 1, and they are
+ * always valid indices: solvers can step into the border without bounds checks.
  */
 class Maze
 {
   public:
     /**
      * @brief Construct a new Maze object
-     * @param width Number of cells horizontally (will be adjusted to odd number)
-     * @param height Number of cells vertically (will be adjusted to odd number)
+     * @param width Number of cells horizontally (will be adjusted to odd number, at least 11)
+     * @param height Number of cells vertically (will be adjusted to odd number, at least 11)
      * @param seed Optional seed for random number generator (0 = time-based)
+     * @throws std::invalid_argument if a dimension exceeds the largest size the flat grid can index
      */
     Maze(int width, int height, unsigned int seed = 0);
 
+    /**
+     * @brief Construct a maze from a memory-mapped maze file
+     *
+     * The packed rows are decoded straight from the mapping into the grid, the file is never
+     * read into an intermediate buffer. Calling generate() afterwards replaces the loaded maze.
+     * @param file The maze file
+     * @param seed Optional seed for later calls to generate() (0 = time-based)
+     * @throws std::invalid_argument if the file is larger than the flat grid can index
+     */
+    explicit Maze(const MazeFile &file, unsigned int seed = 0);
+
+    /**
+     * @brief Copy the grid, terrain costs, start, end and random state of a maze
+     * The drawing state is not copied; the first draw() of the copy creates its own textures.
+     * @param other The maze to copy
+     */
+    Maze(const Maze &other);
+
+    /**
+     * @brief Save the maze to a maze file (see MazeFile.h)
+     *
+     * Every cell that is not a wall is stored as open, so visualization markers are not saved.
+     * @param path File to create (an existing file is replaced)
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string &path) const;
+
     /**
      * @brief Generate a new random maze
      *
-     * Uses recursive backtracking algorithm to create a perfect maze
-     * (one with no loops and exactly one path between any two points)
+     * Creates a perfect maze (one with no loops and exactly one path between any two points),
+     * then knocks out walls if setWallRemovalPercent() asked for it, and records the generation
+     * time and throughput. None of the generators recurse, so the size is only limited by memory.
+     * @param algorithm Generation algorithm (recursive backtracking by default)
      */
-    void generate();
+    void generate(GenerationAlgorithm algorithm = GenerationAlgorithm::RecursiveBacktracker);
+
+    /**
+     * @brief Get the time the last call to generate() took
+     * @return Seconds spent generating, 0 if generate() was never called
+     */
+    double getGenerationSeconds() const
+    {
+        return m_generation_seconds;
+    }
+
+    /**
+     * @brief Get the throughput of the last call to generate()
+     * @return Generated cells per second
+     */
+    double getGenerationThroughput() const
+    {
+        return m_generation_throughput;
+    }
+
+    /**
+     * @brief Set the share of walls knocked out after each call to generate()
+     *
+     * Each wall inside the outer border is removed with this probability once the perfect maze
+     * is carved, which adds loops and, at higher percentages, open rooms.
+     * @param percent Percentage between 0 (perfect maze) and 100 (open grid)
+     * @throws std::invalid_argument if percent is outside [0, 100]
+     */
+    void setWallRemovalPercent(int percent);
+    int getWallRemovalPercent() const
+    {
+        return m_wall_removal_percent;
+    }
+
+    /**
+     * @brief Cover the maze with random terrain, square patches of cells that each get one random cost
+     *
+     * Entering a cell costs its terrain cost (1 for a road, more for mud). Without terrain every
+     * cell costs 1. The layer outlives generate(), so a new maze is laid over the same terrain.
+     * Only DijkstraSearch and AStarSearch read the costs, the other solvers count steps.
+     * @param maxCost Highest cost of a patch, between 1 and 255
+     * @throws std::invalid_argument if maxCost is outside [1, 255]
+     */
+    void generateTerrain(int maxCost);
+    /**
+     * @brief Set the terrain cost of one cell, creating a flat terrain layer first if there is none
+     * @param row Row index
+     * @param col Column index
+     * @param cost Cost of entering the cell, between 1 and 255
+     * @throws std::invalid_argument if cost is outside [1, 255]
+     */
+    void setCost(int row, int col, int cost);
+    /**
+     * @brief Remove the terrain layer, every cell costs 1 again
+     */
+    void clearTerrain();
+    /**
+     * @brief Check if the maze has a terrain layer
+     */
+    bool hasTerrain() const
+    {
+        return !m_costs.empty();
+    }
+    /**
+     * @brief Get the cost of entering a cell by flat grid index (no bounds check)
+     */
+    int getCost(int index) const
+    {
+        return m_costs.empty() ? 1 : m_costs[index];
+    }
+    /**
+     * @brief Get the lowest cost of any cell inside the border, 1 without terrain
+     */
+    int getMinCost() const;
 
     // get the minimum window size needed to display the maze based on its dimensions
     void getWindowSize(int &width, int &height, int maxWidth, int maxHeight);
@@ -88,13 +262,12 @@ class Maze
     void resetVisualization();
 
     /**
-     * @brief Get the cell at a specific position
+     * @brief Get the type of the cell at a specific position
      * @param row Row index
      * @param col Column index
-     * @return Reference to the cell
+     * @return Type of the cell
      */
-    Cell &getCell(int row, int col);
-    const Cell &getCell(int row, int col) const;
+    CellType getCellType(int row, int col) const;
 
     /**
      * @brief Set the type of a cell
@@ -104,6 +277,94 @@ class Maze
      */
     void setCellType(int row, int col, CellType type);
 
+    /**
+     * @brief Get the flat index of a cell in the padded grid
+     * @param row Row index (-1 and getHeight() address the border)
+     * @param col Column index (-1 and getWidth() address the border)
+     * @return Index into the grid
+     */
+    int cellIndex(int row, int col) const
+    {
+        return (row + 1) * m_stride + (col + 1);
+    }
+
+    /**
+     * @brief Get the row and column of a flat grid index
+     */
+    int rowOf(int index) const
+    {
+        return index / m_stride - 1;
+    }
+    int colOf(int index) const
+    {
+        return index % m_stride - 1;
+    }
+
+    /**
+     * @brief Get the distance between vertically adjacent cells in the flat grid
+     */
+    int getStride() const
+    {
+        return m_stride;
+    }
+
+    /**
+     * @brief Get the number of entries in the flat grid, including the border
+     */
+    int getCellCount() const
+    {
+        return static_cast<int>(m_cells.size());
+    }
+
+    /**
+     * @brief Get or set a cell type by flat grid index (no bounds check)
+     */
+    CellType getCellType(int index) const
+    {
+        return m_cells[index];
+    }
+    void setCellType(int index, CellType type)
+    {
+        m_cells[index] = type;
+        m_dirty_blocks[index >> DIRTY_BLOCK_SHIFT] = 1;
+    }
+
+    /**
+     * @brief Get the whole flat grid, getCellCount() entries
+     */
+    const CellType *getCells() const
+    {
+        return m_cells.data();
+    }
+
+    /**
+     * @brief Overwrite a run of consecutive flat grid indices (no bounds check)
+     * Only the cells whose type differs count as changed, so copying back a run that is mostly unchanged redraws little.
+     * @param index Flat grid index of the first cell
+     * @param types New types of the cells
+     * @param count Number of cells
+     */
+    void setCellTypes(int index, const CellType *types, int count);
+
+    // log2 of the flat grid indices per change block: 64 cells, so flagging a block is a shift and a block spans few rows
+    static constexpr int DIRTY_BLOCK_SHIFT = 6;
+
+    /**
+     * @brief Get and clear the blocks of flat grid indices changed since the last draw() or call
+     * For mazes that are never drawn, such as a copy a solver works on in another thread. Block b holds the indices from
+     * b << DIRTY_BLOCK_SHIFT up to the next block or the end of the grid.
+     * @param blocks Receives the changed blocks in increasing order; its capacity is reused
+     */
+    void takeChangedBlocks(std::vector<int> &blocks);
+
+    /**
+     * @brief Check if the cell at a flat grid index can be traversed (no bounds check)
+     */
+    bool isPassable(int index) const
+    {
+        return m_cells[index] != CellType::Wall;
+    }
+
     /**
      * @brief Get maze dimensions
      */
@@ -130,8 +391,8 @@ class Maze
 
     /**
      * @brief Check if a position is valid and traversable
-     * @param row Row index
-     * @param col Column index
+     * @param row Row index, may be one step outside the maze (the border is a wall)
+     * @param col Column index, may be one step outside the maze (the border is a wall)
      * @return true if the cell can be traversed
      */
     bool isValidPath(int row, int col) const;
@@ -141,36 +402,103 @@ class Maze
      */
     bool isInBounds(int row, int col) const;
 
+    /**
+     * @brief Get the cell drawn at a pixel of the window
+     * @param x Horizontal pixel coordinate
+     * @param y Vertical pixel coordinate
+     * @param row Receives the row of the cell
+     * @param col Receives the column of the cell
+     * @return false if the pixel is outside the maze
+     */
+    bool cellAt(int x, int y, int &row, int &col) const;
+
+    /**
+     * @brief Draw the maze with one sprite scaled from a texture of one texel per cell
+     * Only the rows holding cells changed since the previous call are recolored and uploaded.
+     * @param window The window to draw to
+     */
     void draw(sf::RenderWindow &window);
 
   private:
     int m_width;
     int m_height;
-    int m_cell_size; // Size of each cell in pixels
-    std::vector<std::vector<Cell>> m_grid;
+    int m_cell_size;                   // Size of each cell in pixels
+    int m_stride;                      // Grid entries per row, m_width plus the left and right border
+    std::vector<CellType> m_cells;     // Padded row-major grid, see class description
+    double m_generation_seconds;       // Time of the last generate()
+    double m_generation_throughput;    // Cells per second of the last generate()
+    int m_wall_removal_percent;        // Walls knocked out by generate(), see setWallRemovalPercent()
+    std::vector<std::uint8_t> m_costs; // Terrain cost per flat grid index, empty when every cell costs 1
     std::pair<int, int> m_start;
     std::pair<int, int> m_end;
     std::mt19937 m_rng; // Random number generator
 
+    // Drawing state, created by the first draw() so mazes that are never shown need no graphics context
+    std::unique_ptr<sf::Texture> m_texture;         // One texel per cell
+    std::unique_ptr<sf::Texture> m_outline_texture; // One cell with its right and bottom border, repeated over the maze
+    std::vector<sf::Uint8> m_pixels;                // RGBA of every texel of m_texture
+    std::vector<std::uint8_t> m_dirty_blocks;       // Per block of flat grid indices: set if a cell of it may differ from m_texture
+
+    /**
+     * @brief Mark every cell as changed since the last draw()
+     */
+    void invalidateDrawing()
+    {
+        m_dirty_blocks.assign((m_cells.size() >> DIRTY_BLOCK_SHIFT) + 1, 1);
+    }
+
+    /**
+     * @brief Upload rows [firstRow, lastRow] of m_pixels to m_texture, nothing if the range is empty
+     */
+    void uploadRows(int firstRow, int lastRow);
+
     /**
      * @brief Initialize the grid with all walls
      */
     void initializeGrid();
 
     /**
-     * @brief Recursive backtracking maze generation
-     * @param row Current row
-     * @param col Current column
+     * @brief Backtracking maze generation without recursion
+     * The backtracking trail is one direction byte per room instead of the call stack.
+     * @param row Starting row
+     * @param col Starting column
      */
     void carvePassages(int row, int col);
 
     /**
-     * @brief Get unvisited neighbors for maze generation
-     * @param row Current row
-     * @param col Current column
-     * @return Vector of neighbor positions
+     * @brief Wilson's algorithm: grow the maze with loop-erased random walks
+     */
+    void generateWilson();
+
+    /**
+     * @brief Eller's algorithm: carve the maze row by row with an EllerRowGenerator
+     */
+    void generateEller();
+
+    /**
+     * @brief Kruskal's algorithm: remove walls in random order when they join two different trees
+     * The random order is a keyed permutation of the wall numbers, so no wall list is stored.
+     */
+    void generateKruskal();
+
+    /**
+     * @brief Knock out m_wall_removal_percent percent of the walls inside the outer border
+     */
+    void removeWalls();
+
+    /**
+     * @brief Open the wall between two adjacent rooms and carve both rooms
+     * @param roomA Room index (roomRow * roomColumns + roomCol)
+     * @param roomB Adjacent room index
+     */
+    void connectRooms(int roomA, int roomB);
+
+    /**
+     * @brief Get the flat grid index of a room (an odd row, odd column cell)
+     * @param room Room index (roomRow * roomColumns + roomCol)
+     * @return Index into the grid
      */
-    std::vector<std::pair<int, int>> getUnvisitedNeighbors(int row, int col);
+    int roomCellIndex(int room) const;
 
     /**
      * @brief Calculate the minimum window size needed to display the maze based on its dimensions
@@ -8,127 +8,279 @@ This file uses sample code provided in PathfindingNotes.md and makes slight modi
 to implement the required functionality for Homework 1.
 The MazeSolver class is an abstract base class that defines the interface for maze solving algorithms.
 The BreadthFirstSearch and AStarSearch classes inherit from MazeSolver and implement the BFS and A* algorithms, respectively.
+BidirectionalBFS and BidirectionalAStar run the same searches from both ends at once and join them where they meet.
+ParallelBFS expands each BFS layer with OpenMP threads, switching between top-down and bottom-up layers.
+JumpPointSearch is A* that jumps along straight lines and only opens the cells where the path may have to turn.
+BitboardBFS runs BFS on bitmaps of the grid, expanding 64 cells of a layer with a few word operations.
+DijkstraSearch finds the cheapest path over the terrain costs of the maze with a radix heap.
+SolverWorkspace holds the scratch memory of the solvers, shared between them and kept between searches and mazes.
 */
 
 #include "MazeSolver.h"
 #include "MazeGenerator.h"
 #include <algorithm>
+#include <iterator>
 #include <limits>
-#include <list>
+#include <omp.h>
 #include <vector>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#define BOTTOM_UP_ALPHA 14      // Expand bottom-up once a layer holds more than 1/14 of the unexplored cells
+#define TOP_DOWN_BETA 24        // Back to top-down once a shrinking layer holds less than 1/24 of the passable cells
+#define TOP_DOWN_CHUNK 256      // Layer cells per scheduling chunk
+#define MIN_PARALLEL_LAYER 1024 // Smaller layers are expanded top-down by the calling thread alone
+#define BOTTOM_UP_CHUNK 64      // Visited bitmap words (4096 cells) per scheduling chunk
+#define UNREACHED (std::numeric_limits<int>::max() / 2) // g-score and rhs of cells with no known path, safe to add 1 to
+
+/**
+ * @brief Get the index of the lowest set bit
+ * @param bits Non-zero word
+ * @return Bit index between 0 and 63
+ */
+static int lowestSetBit(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+/**
+ * @brief Get the index of the highest set bit
+ * @param bits Non-zero word
+ * @return Bit index between 0 and 31
+ */
+static int highestSetBit(std::uint32_t bits)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, bits);
+    return static_cast<int>(index);
+#else
+    return 31 - __builtin_clz(bits);
+#endif
+}
+
+/**
+ * @brief Count the set bits of a word
+ * @param bits Any word
+ * @return Number of set bits
+ */
+static int countSetBits(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(bits));
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
+
+constexpr int BucketOpenSet::LEVELS;
+constexpr int RadixHeap::BUCKETS;
+constexpr int SolverWorkspace::SIDES;
+constexpr int SolverWorkspace::QUEUES;
+constexpr int SolverWorkspace::UNSET;
+
 // Define static constexpr members of MazeSolver
 constexpr int MazeSolver::DIRECTION_ROW[];
 constexpr int MazeSolver::DIRECTION_COL[];
 constexpr int MazeSolver::NUM_DIRECTIONS;
 
-MazeSolver::MazeSolver(Maze &maze)
-    : m_maze(maze), start{maze.getStart().first, maze.getStart().second}, end{maze.getEnd().first, maze.getEnd().second}, terminator{-1, -1}
+void SolverWorkspace::reserve(int cellCount)
+{
+    if (cellCount <= capacity)
+    {
+        return;
+    }
+
+    // New entries carry stamp 0, which no search uses, so they read as not reached
+    for (int side = 0; side < SIDES; ++side)
+    {
+        stamps[side].resize(cellCount, 0);
+        values[side].resize(cellCount);
+        // Four 2-bit directions per byte; a root has no parent, reconstruction stops there
+        trees[side].resize((cellCount + 3) / 4, 0);
+    }
+    capacity = cellCount;
+}
+
+void SolverWorkspace::beginSearch(int cellCount)
+{
+    reserve(cellCount);
+    if (++search == 0)
+    {
+        // The numbers start over after 255 searches, so the stamps they left must not match again
+        for (auto &side : stamps)
+        {
+            std::fill(side.begin(), side.end(), 0);
+        }
+        search = 1;
+    }
+}
+
+std::size_t SolverWorkspace::getMemoryUsage() const
+{
+    std::size_t bytes = heap.capacity() * sizeof(Node) + path.capacity() * sizeof(Position);
+    for (int side = 0; side < SIDES; ++side)
+    {
+        bytes += stamps[side].capacity() + values[side].capacity() * sizeof(int) + trees[side].capacity();
+    }
+    for (const auto &queue : queues)
+    {
+        bytes += queue.capacity() * sizeof(int);
+    }
+    return bytes;
+}
+
+MazeSolver::MazeSolver(Maze &maze, SolverWorkspace *workspace)
+    : m_maze(maze), start{maze.getStart().first, maze.getStart().second}, end{maze.getEnd().first, maze.getEnd().second},
+      startIndex(maze.cellIndex(start.row, start.col)), endIndex(maze.cellIndex(end.row, end.col)),
+      neighborOffset{-maze.getStride(), maze.getStride(), -1, 1},
+      ownedWorkspace(workspace ? nullptr : std::make_unique<SolverWorkspace>()),
+      workspace(workspace ? *workspace : *ownedWorkspace), cameFrom(this->workspace.getTree(0)), path(this->workspace.getPath())
 {
-    cameFrom[start] = terminator; // Sentinel value for start
+    this->workspace.reserve(maze.getCellCount());
+    nodesExplored = 0;
 }
 
 void MazeSolver::reset()
 {
-    cameFrom.clear();
-    cameFrom[start] = terminator;
+    // cameFrom is overwritten for every cell the next search reaches, so it does not need to be cleared
+    path.clear();
+    nodesExplored = 0;
 }
 
-std::list<Position> MazeSolver::reconstructPath()
+std::size_t MazeSolver::branchLength(int index, int root, const std::vector<std::uint8_t> &tree) const
 {
-    std::list<Position> path;
-    Position current = end;
+    std::size_t length = 1;
+    for (; index != root; index = parentOf(index, tree))
+    {
+        ++length;
+    }
+    return length;
+}
 
-    while (current != terminator)
+void MazeSolver::writeBranch(int index, int root, const std::vector<std::uint8_t> &tree, std::ptrdiff_t first, int stride)
+{
+    for (std::ptrdiff_t i = first;; i += stride)
     {
-        path.push_back(current);
-        current = cameFrom[current];
+        path[i] = {m_maze.rowOf(index), m_maze.colOf(index)};
 
-        // Mark solution path for visualization
-        if (current != start)
-        { // Avoid overwriting start cell
-            m_maze.setCellType(current.row, current.col, CellType::Solution);
+        // Mark solution path for visualization, leaving the start and end cells alone
+        if (index != startIndex && index != endIndex)
+        {
+            m_maze.setCellType(index, CellType::Solution);
+        }
+        if (index == root)
+        {
+            return;
         }
+        index = parentOf(index, tree);
     }
+}
+
+const std::vector<Position> &MazeSolver::reconstructPath()
+{
+    // Count the steps first so the path is sized once, then fill it from end back to start
+    path.resize(branchLength(endIndex, startIndex, cameFrom));
+    writeBranch(endIndex, startIndex, cameFrom, 0, 1);
+    return path;
+}
 
+const std::vector<Position> &MazeSolver::joinBranches(int meeting, const std::vector<std::uint8_t> &fromStart,
+                                                      const std::vector<std::uint8_t> &fromEnd)
+{
+    // end ... meeting is the branch of the end tree written backwards, the rest continues down the start tree
+    const std::size_t toEnd = branchLength(meeting, endIndex, fromEnd);
+    path.resize(toEnd + branchLength(meeting, startIndex, fromStart) - 1);
+    writeBranch(meeting, endIndex, fromEnd, static_cast<std::ptrdiff_t>(toEnd) - 1, -1);
+    if (meeting != startIndex)
+    {
+        writeBranch(parentOf(meeting, fromStart), startIndex, fromStart, static_cast<std::ptrdiff_t>(toEnd), 1);
+    }
     return path;
 }
 
-BreadthFirstSearch::BreadthFirstSearch(Maze &maze) : MazeSolver(maze)
+int MazeSolver::manhattanDistance(const Position a, const Position b)
+{
+    return std::abs(a.row - b.row) + std::abs(a.col - b.col);
+}
+
+BreadthFirstSearch::BreadthFirstSearch(Maze &maze, SolverWorkspace *workspace)
+    : MazeSolver(maze, workspace), frontier(this->workspace.getQueue(0))
 {
-    // Initialize 2D visited array with maze dimensions, all false
-    visited.assign(maze.getHeight(), std::vector<bool>(maze.getWidth(), false));
-    frontier.push(start);
-    visited[start.row][start.col] = true;
+    reset();
 }
 
 void BreadthFirstSearch::reset()
 {
     MazeSolver::reset();
 
-    // Clear all data structures
-    while (!frontier.empty())
-        frontier.pop();
-    // Reset visited array instead of clearing (more efficient)
-    for (auto &row : visited)
-    {
-        std::fill(row.begin(), row.end(), false);
-    }
+    // A new search number marks every cell as unvisited without touching them
+    workspace.beginSearch(m_maze.getCellCount());
 
     // Reinitialize with start position
-    frontier.push(start);
-    visited[start.row][start.col] = true;
+    frontier.assign(1, startIndex);
+    head = 0;
+    workspace.markReached(0, startIndex);
 }
 
-std::list<Position> BreadthFirstSearch::solveMaze()
+const std::vector<Position> &BreadthFirstSearch::solveMaze()
 {
-    int nodesExploredCount = 0;
-    while (!frontier.empty())
+    nodesExplored = 0;
+    while (head < frontier.size())
     {
-        if (step(nodesExploredCount))
+        if (step(nodesExplored))
         {
             return reconstructPath(); // Mark the path on the maze
         }
     }
 
-    return {}; // No path found
+    path.clear();
+    return path; // No path found
 }
 
 bool BreadthFirstSearch::step(int &nodesExploredCount)
 {
     // check if search is complete
-    if (frontier.empty())
+    if (head == frontier.size())
     {
         return false; // No path found - all reachable cells explored
     }
 
     // process next cell
-    Position current = frontier.front();
-    frontier.pop();
+    int current = frontier[head++];
 
     // Check if we've reached the goal
-    if (current == end)
+    if (current == endIndex)
     {
         return true; // Path found!
     }
 
     // explore neighbors in order: UP, DOWN, LEFT, RIGHT
+    // Neighbors are flat grid offsets; the wall border keeps them in range so no bounds checks are needed
     for (int i = 0; i < NUM_DIRECTIONS; ++i)
     {
-        Position next = {current.row + DIRECTION_ROW[i], current.col + DIRECTION_COL[i]};
+        int next = current + neighborOffset[i];
 
         // Only visit unvisited, passable cells
-        if (m_maze.isValidPath(next.row, next.col) && !visited[next.row][next.col])
+        if (m_maze.isPassable(next) && !workspace.isReached(0, next))
         {
-            visited[next.row][next.col] = true;
-            cameFrom[next] = current; // Track path for reconstruction
-            frontier.push(next);      // Add to queue for future exploration
+            workspace.markReached(0, next);
+            setCameFrom(next, i);     // Track path for reconstruction
+            frontier.push_back(next); // Add to queue for future exploration
             nodesExploredCount++;
 
             // Mark explored cells (not start/end) as "visited" for UI animation
-            if (m_maze.getCell(next.row, next.col).type == CellType::Path)
+            if (m_maze.getCellType(next) == CellType::Path)
             {
-                m_maze.setCellType(next.row, next.col, CellType::Visited);
+                m_maze.setCellType(next, CellType::Visited);
             }
         }
     }
@@ -136,112 +288,215 @@ bool BreadthFirstSearch::step(int &nodesExploredCount)
     return false; // Continue searching
 }
 
-AStarSearch::AStarSearch(Maze &maze) : MazeSolver(maze)
+bool BreadthFirstSearch::isExhausted() const
+{
+    return head == frontier.size();
+}
+
+void BucketOpenSet::reset(int maxHeuristic)
+{
+    for (auto &level : buckets)
+    {
+        // Never shrink, so a workspace moving between mazes keeps the capacity of every bucket
+        if (level.size() <= static_cast<std::size_t>(maxHeuristic))
+        {
+            level.resize(maxHeuristic + 1);
+        }
+        for (auto &bucket : level)
+        {
+            bucket.clear();
+        }
+    }
+    std::fill(std::begin(count), std::end(count), 0);
+    std::fill(std::begin(lowestHeuristic), std::end(lowestHeuristic), std::numeric_limits<int>::max());
+    size = 0;
+    currentF = std::numeric_limits<int>::max();
+}
+
+void BucketOpenSet::push(int index, int fScore, int heuristic)
+{
+    // The first push after reset() sets the starting f-score; later ones never go below the f-score last popped,
+    // even when they refill an open set that was emptied by that pop
+    currentF = std::min(currentF, fScore);
+    const int level = (fScore / 2) % LEVELS;
+    buckets[level][heuristic].push_back(index);
+    ++count[level];
+    lowestHeuristic[level] = std::min(lowestHeuristic[level], heuristic);
+    ++size;
+}
+
+int BucketOpenSet::pop(int &fScore, int &heuristic)
 {
-    // Initialize 2D arrays with maze dimensions
-    int height = maze.getHeight();
-    int width = maze.getWidth();
-    gScore.assign(height, std::vector<int>(width, std::numeric_limits<int>::max()));
-    inOpenSet.assign(height, std::vector<bool>(width, false));
+    int level = (currentF / 2) % LEVELS;
+    while (count[level] == 0)
+    {
+        // The current f-score is drained, continue with the next one
+        lowestHeuristic[level] = std::numeric_limits<int>::max();
+        currentF += 2;
+        level = (currentF / 2) % LEVELS;
+    }
+
+    auto &levelBuckets = buckets[level];
+    int &lowest = lowestHeuristic[level];
+    while (levelBuckets[lowest].empty())
+    {
+        ++lowest;
+    }
+    const int index = levelBuckets[lowest].back();
+    levelBuckets[lowest].pop_back();
+    --count[level];
+    --size;
 
-    openSet.push({start, manhattanDistance(start, end)});
-    gScore[start.row][start.col] = 0;
-    inOpenSet[start.row][start.col] = true;
+    fScore = currentF;
+    heuristic = lowest;
+    return index;
 }
 
-void AStarSearch::reset()
+AStarSearch::AStarSearch(Maze &maze, OpenSetType type, SolverWorkspace *workspace)
+    : MazeSolver(maze, workspace), openSetType(type), weighted(false), heuristicScale(1), openSet(this->workspace.getHeap()),
+      bucketOpenSet(this->workspace.getBucketOpenSet(0))
 {
-    MazeSolver::reset();
+    initializeOpenSet();
+}
 
-    while (!openSet.empty())
-        openSet.pop();
+void AStarSearch::initializeOpenSet()
+{
+    // A new search number sets every g-score to unset without touching them
+    workspace.beginSearch(m_maze.getCellCount());
+    openSet.clear();
+    // No heuristic value exceeds the distance between opposite corners
+    bucketOpenSet.reset(m_maze.getWidth() + m_maze.getHeight());
 
-    // Reset 2D arrays instead of clearing
-    for (auto &row : gScore)
+    // Terrain is read at every reset, so cost edits between solves are picked up
+    weighted = m_maze.hasTerrain();
+    heuristicScale = m_maze.getMinCost();
+    int startF = heuristicOf(start);
+    workspace.setScore(0, startIndex, 0);
+    if (usesBuckets())
     {
-        std::fill(row.begin(), row.end(), std::numeric_limits<int>::max());
+        bucketOpenSet.push(startIndex, startF, startF);
     }
-    for (auto &row : inOpenSet)
+    else
     {
-        std::fill(row.begin(), row.end(), false);
+        openSet.push_back({startIndex, startF});
     }
+}
+
+void AStarSearch::reset()
+{
+    MazeSolver::reset();
+    initializeOpenSet();
+}
 
-    gScore[start.row][start.col] = 0;
-    openSet.push({start, manhattanDistance(start, end)});
-    inOpenSet[start.row][start.col] = true;
+bool AStarSearch::isOpenSetEmpty() const
+{
+    return usesBuckets() ? bucketOpenSet.empty() : openSet.empty();
 }
 
-std::list<Position> AStarSearch::solveMaze()
+const std::vector<Position> &AStarSearch::solveMaze()
 {
-    int nodesExploredCount = 0;
+    nodesExplored = 0;
 
-    while (!openSet.empty())
+    while (!isOpenSetEmpty())
     {
-        if (step(nodesExploredCount))
+        if (step(nodesExplored))
         {
             return reconstructPath(); // Mark the path on the maze
         }
     }
 
-    return {}; // No path found
+    path.clear();
+    return path; // No path found
 }
 
 bool AStarSearch::step(int &nodesExploredCount)
 {
-    // check if search is complete
-    if (openSet.empty())
+    // Process most promising cell from open set (lowest f-score)
+    int currentIndex;
+    if (usesBuckets())
+    {
+        // A cell whose g-score improved is pushed again instead of being moved, so skip the outdated entries
+        int fScore, heuristic;
+        do
+        {
+            // check if search is complete
+            if (bucketOpenSet.empty())
+            {
+                return false; // No path found - no more cells to explore
+            }
+            currentIndex = bucketOpenSet.pop(fScore, heuristic);
+        } while (workspace.getScore(0, currentIndex) != fScore - heuristic);
+    }
+    else
     {
-        return false; // No path found - no more cells to explore
+        // Priority queue gives us the cell with lowest f-score (best guess at shortest path). A cell is pushed again
+        // when its g-score improves, so skip the entries pushed before
+        Node current;
+        do
+        {
+            // check if search is complete
+            if (openSet.empty())
+            {
+                return false; // No path found - no more cells to explore
+            }
+            std::pop_heap(openSet.begin(), openSet.end(), std::greater<Node>());
+            current = openSet.back();
+            openSet.pop_back();
+        } while (current.fScore !=
+                 workspace.getScore(0, current.index) + heuristicOf({m_maze.rowOf(current.index), m_maze.colOf(current.index)}));
+        currentIndex = current.index;
     }
 
-    // Process most promising cell from open set (lowest f-score)
-    // Priority queue gives us the cell with lowest f-score (best guess at shortest path)
-    Node current = openSet.top();
-    openSet.pop();
-    inOpenSet[current.pos.row][current.pos.col] = false;
-
     // Check if we've reached the goal
-    if (current.pos == end)
+    if (currentIndex == endIndex)
     {
         return true; // Shortest path found!
     }
 
     // A* explores in order: UP, DOWN, LEFT, RIGHT
+    Position currentPos = {m_maze.rowOf(currentIndex), m_maze.colOf(currentIndex)};
+    const int currentG = workspace.getScore(0, currentIndex);
     for (int i = 0; i < NUM_DIRECTIONS; ++i)
     {
-        Position next = {current.pos.row + DIRECTION_ROW[i], current.pos.col + DIRECTION_COL[i]};
+        int next = currentIndex + neighborOffset[i];
 
-        // Only consider valid, passable cells
-        if (m_maze.isValidPath(next.row, next.col))
+        // Only consider valid, passable cells (the wall border makes bounds checks unnecessary)
+        if (m_maze.isPassable(next))
         {
             nodesExploredCount++;
 
             // Calculate path cost
-            // g-score: actual distance from start to next node
-            int tentativeG = gScore[current.pos.row][current.pos.col] + 1;
+            // g-score: actual cost from start to next node, each step costs the terrain of the cell it enters
+            int tentativeG = currentG + m_maze.getCost(next);
 
-            // Check if this is a new cell or if we found a better path to it
-            if (gScore[next.row][next.col] == std::numeric_limits<int>::max() || tentativeG < gScore[next.row][next.col])
+            // Check if this is a new cell or if we found a better path to it (an unset g-score is larger than any)
+            if (tentativeG < workspace.getScore(0, next))
             {
                 // Record this as the best path to 'next' so far
-                cameFrom[next] = current.pos;
-                gScore[next.row][next.col] = tentativeG;
+                Position nextPos = {currentPos.row + DIRECTION_ROW[i], currentPos.col + DIRECTION_COL[i]};
+                setCameFrom(next, i);
+                workspace.setScore(0, next, tentativeG);
 
                 // Calculate heuristic
-                // f-score: estimated total cost = actual cost + Manhattan distance to goal
-                int fScore = tentativeG + manhattanDistance(next, end);
+                // f-score: estimated total cost = actual cost + scaled Manhattan distance to goal
+                int heuristic = heuristicOf(nextPos);
+                int fScore = tentativeG + heuristic;
 
-                // Add to open set only if not already there
-                if (!inOpenSet[next.row][next.col])
+                // Both open sets take every improvement and skip the outdated entries when popping
+                if (usesBuckets())
+                {
+                    bucketOpenSet.push(next, fScore, heuristic);
+                }
+                else
                 {
-                    openSet.push({next, fScore});
-                    inOpenSet[next.row][next.col] = true;
+                    openSet.push_back({next, fScore});
+                    std::push_heap(openSet.begin(), openSet.end(), std::greater<Node>());
+                }
 
-                    // Mark explored cells (not start/end) as "visited" for UI animation
-                    if (m_maze.getCell(next.row, next.col).type == CellType::Path)
-                    {
-                        m_maze.setCellType(next.row, next.col, CellType::Visited);
-                    }
+                // Mark explored cells (not start/end) as "visited" for UI animation
+                if (m_maze.getCellType(next) == CellType::Path)
+                {
+                    m_maze.setCellType(next, CellType::Visited);
                 }
             }
         }
@@ -250,7 +505,1171 @@ bool AStarSearch::step(int &nodesExploredCount)
     return false; // Continue searching
 }
 
-int AStarSearch::manhattanDistance(const Position a, const Position b)
+bool AStarSearch::isExhausted() const
 {
-    return std::abs(a.row - b.row) + std::abs(a.col - b.col);
+    return usesBuckets() ? bucketOpenSet.empty() : openSet.empty();
+}
+
+BidirectionalBFS::BidirectionalBFS(Maze &maze, SolverWorkspace *workspace) : MazeSolver(maze, workspace)
+{
+    for (int s = 0; s < 2; ++s)
+    {
+        sides[s].layer = &this->workspace.getQueue(2 * s);
+        sides[s].nextLayer = &this->workspace.getQueue((2 * s) + 1);
+    }
+    initializeSides();
+}
+
+void BidirectionalBFS::initializeSides()
+{
+    // A new search number marks every cell as not reached by either side
+    workspace.beginSearch(m_maze.getCellCount());
+    const int roots[2] = {startIndex, endIndex};
+    for (int s = 0; s < 2; ++s)
+    {
+        Side &side = sides[s];
+        side.layer->assign(1, roots[s]);
+        side.nextLayer->clear();
+        side.position = 0;
+        workspace.setScore(s, roots[s], 0);
+    }
+    active = 0;
+    bestLength = -1;
+    meeting = -1;
+}
+
+void BidirectionalBFS::reset()
+{
+    MazeSolver::reset();
+    initializeSides();
+}
+
+bool BidirectionalBFS::isExhausted() const
+{
+    if (bestLength >= 0)
+    {
+        return false;
+    }
+    for (const Side &side : sides)
+    {
+        if (side.position == side.layer->size() && side.nextLayer->empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<Position> &BidirectionalBFS::solveMaze()
+{
+    nodesExplored = 0;
+    while (!step(nodesExplored))
+    {
+        if (isExhausted())
+        {
+            path.clear();
+            return path; // No path found
+        }
+    }
+    return reconstructPath(); // Mark the path on the maze
+}
+
+bool BidirectionalBFS::step(int &nodesExploredCount)
+{
+    Side *side = &sides[active];
+    if (side->position == side->layer->size())
+    {
+        // The layer is finished, so every meeting at this depth has been seen
+        if (bestLength >= 0)
+        {
+            return true; // Path found!
+        }
+
+        // Move on to the next layer and let the smaller frontier go next
+        std::swap(side->layer, side->nextLayer);
+        side->nextLayer->clear();
+        side->position = 0;
+        active = (sides[0].layer->size() <= sides[1].layer->size()) ? 0 : 1;
+        side = &sides[active];
+        if (isExhausted())
+        {
+            return false; // No path found - one search explored every cell it can reach
+        }
+    }
+
+    // process next cell of the active layer
+    int current = (*side->layer)[side->position++];
+    int distance = workspace.getScore(active, current) + 1;
+    const int other = active ^ 1;
+
+    // explore neighbors in order: UP, DOWN, LEFT, RIGHT
+    for (int i = 0; i < NUM_DIRECTIONS; ++i)
+    {
+        int next = current + neighborOffset[i];
+        if (!m_maze.isPassable(next) || workspace.isReached(active, next))
+        {
+            continue;
+        }
+
+        workspace.setScore(active, next, distance);
+        setCameFrom(next, i, workspace.getTree(active));
+        side->nextLayer->push_back(next);
+        nodesExploredCount++;
+
+        // The other search already reached this cell: joining both branches here is a path
+        if (workspace.isReached(other, next) && (bestLength < 0 || distance + workspace.getScore(other, next) < bestLength))
+        {
+            bestLength = distance + workspace.getScore(other, next);
+            meeting = next;
+        }
+
+        // Mark explored cells (not start/end) as "visited" for UI animation
+        if (m_maze.getCellType(next) == CellType::Path)
+        {
+            m_maze.setCellType(next, CellType::Visited);
+        }
+    }
+
+    return false; // Continue searching
+}
+
+const std::vector<Position> &BidirectionalBFS::reconstructPath()
+{
+    return joinBranches(meeting, workspace.getTree(0), workspace.getTree(1));
+}
+
+BidirectionalAStar::BidirectionalAStar(Maze &maze, SolverWorkspace *workspace) : MazeSolver(maze, workspace)
+{
+    sides[0].root = start;
+    sides[0].goal = end;
+    sides[1].root = end;
+    sides[1].goal = start;
+    for (int s = 0; s < 2; ++s)
+    {
+        sides[s].openSet = &this->workspace.getBucketOpenSet(s);
+    }
+    initializeSides();
+}
+
+void BidirectionalAStar::initializeSides()
+{
+    // A new search number sets the g-scores of both sides to unset
+    workspace.beginSearch(m_maze.getCellCount());
+    const int roots[2] = {startIndex, endIndex};
+    const int distance = manhattanDistance(start, end);
+    for (int s = 0; s < 2; ++s)
+    {
+        Side &side = sides[s];
+        // A root has g = 0 and potential 2 * distance (see potential()), the largest potential there is
+        side.openSet->reset(2 * distance);
+        workspace.setScore(s, roots[s], 0);
+        side.openSet->push(roots[s], 2 * distance, 2 * distance);
+    }
+    bestLength = std::numeric_limits<int>::max();
+    meeting = -1;
+}
+
+void BidirectionalAStar::reset()
+{
+    MazeSolver::reset();
+    initializeSides();
+}
+
+bool BidirectionalAStar::isExhausted() const
+{
+    return bestLength == std::numeric_limits<int>::max() && (sides[0].openSet->empty() || sides[1].openSet->empty());
+}
+
+const std::vector<Position> &BidirectionalAStar::solveMaze()
+{
+    nodesExplored = 0;
+    while (!step(nodesExplored))
+    {
+        if (isExhausted())
+        {
+            path.clear();
+            return path; // No path found
+        }
+    }
+    return reconstructPath(); // Mark the path on the maze
+}
+
+int BidirectionalAStar::potential(const Side &side, Position position) const
+{
+    // Twice the average of the heuristic toward the goal and the negated heuristic toward the root, shifted by the
+    // start-end distance so it is never negative (the triangle inequality bounds the difference by that distance)
+    return manhattanDistance(position, side.goal) - manhattanDistance(position, side.root) + manhattanDistance(start, end);
+}
+
+bool BidirectionalAStar::step(int &nodesExploredCount)
+{
+    // With key = 2 * g + potential, every path not found yet is at least half the sum of the lowest keys of both open
+    // sets, minus the shift of the potentials; an empty open set means that search has nothing left to find
+    if (sides[0].openSet->empty() || sides[1].openSet->empty() ||
+        (bestLength != std::numeric_limits<int>::max() &&
+         sides[0].openSet->lowestFScore() + sides[1].openSet->lowestFScore() >= 2 * (bestLength + manhattanDistance(start, end))))
+    {
+        return bestLength != std::numeric_limits<int>::max();
+    }
+
+    // Expand the side with fewer open cells, skipping outdated entries of cells whose g-score improved
+    const int s = (sides[0].openSet->getSize() <= sides[1].openSet->getSize()) ? 0 : 1;
+    Side &side = sides[s];
+    int current, key, currentPotential;
+    do
+    {
+        if (side.openSet->empty())
+        {
+            return false; // Checked again on the next step
+        }
+        current = side.openSet->pop(key, currentPotential);
+    } while (workspace.getScore(s, current) * 2 != key - currentPotential);
+
+    // A* explores in order: UP, DOWN, LEFT, RIGHT
+    Position currentPos = {m_maze.rowOf(current), m_maze.colOf(current)};
+    for (int i = 0; i < NUM_DIRECTIONS; ++i)
+    {
+        int next = current + neighborOffset[i];
+        if (!m_maze.isPassable(next))
+        {
+            continue;
+        }
+        nodesExploredCount++;
+
+        int tentativeG = workspace.getScore(s, current) + 1;
+        if (tentativeG < workspace.getScore(s, next))
+        {
+            workspace.setScore(s, next, tentativeG);
+            setCameFrom(next, i, workspace.getTree(s));
+            Position nextPos = {currentPos.row + DIRECTION_ROW[i], currentPos.col + DIRECTION_COL[i]};
+            int nextPotential = potential(side, nextPos);
+            side.openSet->push(next, (2 * tentativeG) + nextPotential, nextPotential);
+
+            // The other search already reached this cell: joining both branches here is a path
+            if (workspace.isReached(s ^ 1, next) && tentativeG + workspace.getScore(s ^ 1, next) < bestLength)
+            {
+                bestLength = tentativeG + workspace.getScore(s ^ 1, next);
+                meeting = next;
+            }
+
+            // Mark explored cells (not start/end) as "visited" for UI animation
+            if (m_maze.getCellType(next) == CellType::Path)
+            {
+                m_maze.setCellType(next, CellType::Visited);
+            }
+        }
+    }
+
+    return false; // Continue searching
+}
+
+const std::vector<Position> &BidirectionalAStar::reconstructPath()
+{
+    return joinBranches(meeting, workspace.getTree(0), workspace.getTree(1));
+}
+
+ParallelBFS::ParallelBFS(Maze &maze, int threadCount, SolverWorkspace *workspace)
+    : MazeSolver(maze, workspace), numThreads((threadCount > 0) ? threadCount : omp_get_max_threads()),
+      visited((static_cast<std::size_t>(maze.getCellCount()) + 63) / 64), frontierBits(visited.size()), nextFrontierBits(visited.size())
+{
+    direction.assign(maze.getCellCount(), 0);
+    threadFrontiers.resize(numThreads);
+    threadOffsets.resize(numThreads + 1);
+    initializeSearch();
+}
+
+void ParallelBFS::initializeSearch()
+{
+    const int cellCount = m_maze.getCellCount();
+    const int words = static_cast<int>(visited.size());
+    std::size_t passable = 0;
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(+ : passable)
+    for (int word = 0; word < words; ++word)
+    {
+        // Walls and the padding bits past the last cell start visited, so no layer ever claims them
+        std::uint64_t bits = 0;
+        const int first = word * 64;
+        for (int bit = 0; bit < 64; ++bit)
+        {
+            if (first + bit >= cellCount || !m_maze.isPassable(first + bit))
+            {
+                bits |= 1ull << bit;
+            }
+            else
+            {
+                ++passable;
+            }
+        }
+        visited[word].store(bits, std::memory_order_relaxed);
+    }
+
+    visited[startIndex >> 6].fetch_or(1ull << (startIndex & 63), std::memory_order_relaxed);
+    frontier.assign(1, startIndex);
+    passableCells = passable;
+    unexplored = passable - 1;
+    previousFrontier = 0;
+    bottomUp = false;
+    bottomUpLayers = 0;
+}
+
+void ParallelBFS::reset()
+{
+    MazeSolver::reset();
+    initializeSearch();
+}
+
+const std::vector<Position> &ParallelBFS::solveMaze()
+{
+    nodesExplored = 0;
+    while (!frontier.empty())
+    {
+        if (step(nodesExplored))
+        {
+            return reconstructPath(); // Mark the path on the maze
+        }
+    }
+
+    path.clear();
+    return path; // No path found
+}
+
+bool ParallelBFS::step(int &nodesExploredCount)
+{
+    // check if search is complete
+    if (frontier.empty())
+    {
+        return false; // No path found - all reachable cells explored
+    }
+
+    chooseDirection();
+    if (bottomUp)
+    {
+        expandBottomUp();
+        frontierBits.swap(nextFrontierBits);
+        ++bottomUpLayers;
+    }
+    else
+    {
+        expandTopDown();
+    }
+    previousFrontier = frontier.size();
+    frontier.swap(nextFrontier);
+    unexplored -= frontier.size();
+    nodesExploredCount += static_cast<int>(frontier.size());
+
+    // The new layer is marked for UI animation here, not by the threads that found it: setCellType also widens the
+    // maze's range of changed cells, which threads cannot update together
+    for (int cell : frontier)
+    {
+        if (m_maze.getCellType(cell) == CellType::Path)
+        {
+            m_maze.setCellType(cell, CellType::Visited);
+        }
+    }
+
+    // The goal is in the new layer once its visited bit is set
+    return ((visited[endIndex >> 6].load(std::memory_order_relaxed) >> (endIndex & 63)) & 1) != 0;
+}
+
+bool ParallelBFS::isExhausted() const
+{
+    return frontier.empty();
+}
+
+void ParallelBFS::chooseDirection()
+{
+    // Beamer's heuristic, counted in cells instead of edges: every cell of a maze has at most four neighbors
+    const std::size_t layer = frontier.size();
+    if (!bottomUp && layer * BOTTOM_UP_ALPHA > unexplored)
+    {
+        // The bottom-up pass looks parents up in a bitmap of the layer
+        bottomUp = true;
+        std::fill(frontierBits.begin(), frontierBits.end(), 0);
+        for (int cell : frontier)
+        {
+            frontierBits[cell >> 6] |= 1ull << (cell & 63);
+        }
+    }
+    else if (bottomUp && layer < previousFrontier && layer * TOP_DOWN_BETA < passableCells)
+    {
+        bottomUp = false;
+    }
+}
+
+void ParallelBFS::expandTopDown()
+{
+    // Corridors of a perfect maze keep most layers tiny, too small to pay for waking the other threads
+    const int layerSize = static_cast<int>(frontier.size());
+#pragma omp parallel num_threads(numThreads) if (layerSize >= MIN_PARALLEL_LAYER)
+    {
+        std::vector<int> &local = threadFrontiers[omp_get_thread_num()];
+        local.clear();
+
+#pragma omp for schedule(dynamic, TOP_DOWN_CHUNK)
+        for (int i = 0; i < layerSize; ++i)
+        {
+            const int current = frontier[i];
+
+            // explore neighbors in order: UP, DOWN, LEFT, RIGHT
+            for (int d = 0; d < NUM_DIRECTIONS; ++d)
+            {
+                const int next = current + neighborOffset[d];
+                std::atomic<std::uint64_t> &word = visited[next >> 6];
+                const std::uint64_t bit = 1ull << (next & 63);
+
+                // The plain load skips the cells already visited (most of them), fetch_or decides which thread claims the rest
+                if ((word.load(std::memory_order_relaxed) & bit) != 0 || (word.fetch_or(bit, std::memory_order_relaxed) & bit) != 0)
+                {
+                    continue;
+                }
+                direction[next] = static_cast<std::uint8_t>(d);
+                local.push_back(next);
+            }
+        }
+
+        gatherThreadFrontiers();
+    }
+}
+
+void ParallelBFS::expandBottomUp()
+{
+    const int words = static_cast<int>(visited.size());
+#pragma omp parallel num_threads(numThreads)
+    {
+        std::vector<int> &local = threadFrontiers[omp_get_thread_num()];
+        local.clear();
+
+#pragma omp for schedule(dynamic, BOTTOM_UP_CHUNK)
+        for (int word = 0; word < words; ++word)
+        {
+            // Each word of the bitmaps belongs to one thread, and only unvisited passable cells have their bit clear
+            std::uint64_t unvisited = ~visited[word].load(std::memory_order_relaxed);
+            std::uint64_t reached = 0;
+            while (unvisited != 0)
+            {
+                const int bit = lowestSetBit(unvisited);
+                unvisited &= unvisited - 1;
+                const int cell = (word * 64) + bit;
+
+                // The first neighbor found in the layer becomes the parent
+                for (int d = 0; d < NUM_DIRECTIONS; ++d)
+                {
+                    const int parent = cell - neighborOffset[d];
+                    if (((frontierBits[parent >> 6] >> (parent & 63)) & 1) != 0)
+                    {
+                        direction[cell] = static_cast<std::uint8_t>(d);
+                        reached |= 1ull << bit;
+                        local.push_back(cell);
+                        break;
+                    }
+                }
+            }
+            nextFrontierBits[word] = reached;
+            if (reached != 0)
+            {
+                visited[word].fetch_or(reached, std::memory_order_relaxed);
+            }
+        }
+
+        gatherThreadFrontiers();
+    }
+}
+
+void ParallelBFS::gatherThreadFrontiers()
+{
+    // Orphaned inside the parallel region of the caller: the single thread sizes the new layer, then every thread copies
+    // its buffer into its own slice
+#pragma omp single
+    {
+        const int threads = omp_get_num_threads();
+        threadOffsets[0] = 0;
+        for (int t = 0; t < threads; ++t)
+        {
+            threadOffsets[t + 1] = threadOffsets[t] + threadFrontiers[t].size();
+        }
+        nextFrontier.resize(threadOffsets[threads]);
+    }
+
+    const int thread = omp_get_thread_num();
+    std::copy(threadFrontiers[thread].begin(), threadFrontiers[thread].end(),
+              nextFrontier.begin() + static_cast<std::ptrdiff_t>(threadOffsets[thread]));
+}
+
+const std::vector<Position> &ParallelBFS::reconstructPath()
+{
+    // Threads record parents one byte per cell; only the cells of the path are packed for the base class
+    for (int index = endIndex; index != startIndex; index -= neighborOffset[direction[index]])
+    {
+        setCameFrom(index, direction[index]);
+    }
+    return MazeSolver::reconstructPath();
+}
+
+JumpPointSearch::JumpPointSearch(Maze &maze, SolverWorkspace *workspace)
+    : MazeSolver(maze, workspace), openSet(this->workspace.getHeap())
+{
+    initializeOpenSet();
+}
+
+void JumpPointSearch::initializeOpenSet()
+{
+    // A new search number sets every g-score to unset without touching them
+    workspace.beginSearch(m_maze.getCellCount());
+    openSet.assign(1, {startIndex, manhattanDistance(start, end)});
+    cellsScanned = 0;
+    workspace.setScore(0, startIndex, 0);
+}
+
+void JumpPointSearch::reset()
+{
+    MazeSolver::reset();
+    initializeOpenSet();
+}
+
+const std::vector<Position> &JumpPointSearch::solveMaze()
+{
+    nodesExplored = 0;
+    while (!openSet.empty())
+    {
+        if (step(nodesExplored))
+        {
+            return reconstructPath(); // Mark the path on the maze
+        }
+    }
+
+    path.clear();
+    return path; // No path found
+}
+
+int JumpPointSearch::jumpHorizontal(int index, int offset)
+{
+    const int stride = m_maze.getStride();
+    for (;; index += offset)
+    {
+        if (!m_maze.isPassable(index))
+        {
+            return -1;
+        }
+        ++cellsScanned;
+        if (index == endIndex)
+        {
+            return index;
+        }
+
+        // Forced neighbor: the cell above or below is open but the one diagonally behind is blocked, so the only
+        // shortest way into it turns here
+        if ((m_maze.isPassable(index - stride) && !m_maze.isPassable(index - offset - stride)) ||
+            (m_maze.isPassable(index + stride) && !m_maze.isPassable(index - offset + stride)))
+        {
+            return index;
+        }
+    }
+}
+
+int JumpPointSearch::jumpVertical(int index, int offset)
+{
+    for (;; index += offset)
+    {
+        if (!m_maze.isPassable(index))
+        {
+            return -1;
+        }
+        ++cellsScanned;
+        if (index == endIndex)
+        {
+            return index;
+        }
+        if ((m_maze.isPassable(index - 1) && !m_maze.isPassable(index - 1 - offset)) ||
+            (m_maze.isPassable(index + 1) && !m_maze.isPassable(index + 1 - offset)))
+        {
+            return index;
+        }
+
+        // Horizontal moves come after vertical ones in the canonical ordering, so the cell is also a jump point when
+        // a horizontal jump from it finds one
+        if (jumpHorizontal(index - 1, -1) >= 0 || jumpHorizontal(index + 1, 1) >= 0)
+        {
+            return index;
+        }
+    }
+}
+
+bool JumpPointSearch::step(int &nodesExploredCount)
+{
+    // A jump point whose g-score improved is pushed again instead of being moved, so skip the outdated entries
+    int current;
+    Position currentPos;
+    Node node;
+    do
+    {
+        // check if search is complete
+        if (openSet.empty())
+        {
+            return false; // No path found - no more jump points to expand
+        }
+        std::pop_heap(openSet.begin(), openSet.end(), std::greater<Node>());
+        node = openSet.back();
+        openSet.pop_back();
+        current = node.index;
+        currentPos = {m_maze.rowOf(current), m_maze.colOf(current)};
+    } while (node.fScore != workspace.getScore(0, current) + manhattanDistance(currentPos, end));
+
+    // Check if we've reached the goal
+    if (current == endIndex)
+    {
+        return true; // Shortest path found!
+    }
+
+    // Jump in order: UP, DOWN, LEFT, RIGHT, never back the way the jump point was reached (the opposite of d is d ^ 1)
+    const int reverse = (current == startIndex) ? -1 : cameFromDirection(current, cameFrom) ^ 1;
+    const int currentG = workspace.getScore(0, current);
+    for (int i = 0; i < NUM_DIRECTIONS; ++i)
+    {
+        if (i == reverse)
+        {
+            continue;
+        }
+        const int first = current + neighborOffset[i];
+        const int jumpPoint = (DIRECTION_ROW[i] != 0) ? jumpVertical(first, neighborOffset[i]) : jumpHorizontal(first, neighborOffset[i]);
+        if (jumpPoint < 0)
+        {
+            continue;
+        }
+        nodesExploredCount++;
+
+        // The jump is a straight run, so its cost is the distance between both cells
+        Position jumpPos = {m_maze.rowOf(jumpPoint), m_maze.colOf(jumpPoint)};
+        int tentativeG = currentG + manhattanDistance(currentPos, jumpPos);
+        if (tentativeG < workspace.getScore(0, jumpPoint))
+        {
+            workspace.setScore(0, jumpPoint, tentativeG);
+            setCameFrom(jumpPoint, i);
+            openSet.push_back({jumpPoint, tentativeG + manhattanDistance(jumpPos, end)});
+            std::push_heap(openSet.begin(), openSet.end(), std::greater<Node>());
+
+            // Mark jump points (not start/end) as "visited" for UI animation
+            if (m_maze.getCellType(jumpPoint) == CellType::Path)
+            {
+                m_maze.setCellType(jumpPoint, CellType::Visited);
+            }
+        }
+    }
+
+    return false; // Continue searching
+}
+
+bool JumpPointSearch::isExhausted() const
+{
+    return openSet.empty();
+}
+
+const std::vector<Position> &JumpPointSearch::reconstructPath()
+{
+    // Give the cells skipped by each jump the direction of the jump. Walking back from a jump point, its parent is
+    // the first cell whose g-score is smaller by exactly the distance walked.
+    for (int index = endIndex; index != startIndex;)
+    {
+        const int direction = cameFromDirection(index, cameFrom);
+        const int g = workspace.getScore(0, index);
+        int cell = index - neighborOffset[direction];
+        for (int steps = 1; workspace.getScore(0, cell) != g - steps; ++steps)
+        {
+            setCameFrom(cell, direction);
+            cell -= neighborOffset[direction];
+        }
+        index = cell;
+    }
+    return MazeSolver::reconstructPath();
+}
+
+BitboardBFS::BitboardBFS(Maze &maze, SolverWorkspace *workspace)
+    : MazeSolver(maze, workspace), rowWords((maze.getStride() + 63) / 64), depth(0)
+{
+    // One row of words per grid row, border rows included, so the rows above and below are always in range
+    const std::size_t words = static_cast<std::size_t>(rowWords) * (maze.getHeight() + 2);
+    open.assign(words, 0);
+    visited.assign(words, 0);
+    layer.assign(words, 0);
+    nextLayer.assign(words, 0);
+    labelLow.assign(words, 0);
+    labelHigh.assign(words, 0);
+    initializeLayers();
+}
+
+int BitboardBFS::wordOf(int index, std::uint64_t &mask) const
+{
+    const int row = index / m_maze.getStride();
+    const int col = index % m_maze.getStride();
+    mask = 1ull << (col % 64);
+    return (row * rowWords) + (col / 64);
+}
+
+void BitboardBFS::initializeLayers()
+{
+    std::fill(open.begin(), open.end(), 0);
+    std::fill(visited.begin(), visited.end(), 0);
+    std::fill(labelLow.begin(), labelLow.end(), 0);
+    std::fill(labelHigh.begin(), labelHigh.end(), 0);
+    for (int word : activeWords)
+    {
+        layer[word] = 0;
+    }
+
+    // Border cells are walls, so their bits (and the padding bits after each row) stay clear
+    const int stride = m_maze.getStride();
+    for (int row = 1; row <= m_maze.getHeight(); ++row)
+    {
+        std::uint64_t *rowBits = &open[static_cast<std::size_t>(row) * rowWords];
+        for (int col = 1; col <= m_maze.getWidth(); ++col)
+        {
+            if (m_maze.isPassable((row * stride) + col))
+            {
+                rowBits[col / 64] |= 1ull << (col % 64);
+            }
+        }
+    }
+
+    std::uint64_t mask;
+    const int word = wordOf(startIndex, mask);
+    visited[word] = mask;
+    layer[word] = mask;
+    activeWords.assign(1, word);
+    depth = 0;
+}
+
+void BitboardBFS::reset()
+{
+    MazeSolver::reset();
+    initializeLayers();
+}
+
+const std::vector<Position> &BitboardBFS::solveMaze()
+{
+    nodesExplored = 0;
+    while (!activeWords.empty())
+    {
+        if (expandLayer(false, nodesExplored))
+        {
+            return reconstructPath(); // Mark the path on the maze
+        }
+    }
+
+    path.clear();
+    return path; // No path found
+}
+
+bool BitboardBFS::step(int &nodesExploredCount)
+{
+    return expandLayer(true, nodesExploredCount);
+}
+
+bool BitboardBFS::isExhausted() const
+{
+    return activeWords.empty();
+}
+
+bool BitboardBFS::expandLayer(bool markVisited, int &nodesExploredCount)
+{
+    // check if search is complete
+    if (activeWords.empty())
+    {
+        return false; // No path found - all reachable cells explored
+    }
+
+    // Scatter the neighbors of every non-empty word of the layer: its shifts left and right, the cells that cross
+    // into the words before and after it, and the same bits in the rows above and below. The first and last cells
+    // of a grid row are border walls, so nothing spreads from one grid row into the next.
+    candidateWords.clear();
+    auto spread = [this](int word, std::uint64_t cells) {
+        if (cells != 0)
+        {
+            if (nextLayer[word] == 0)
+            {
+                candidateWords.push_back(word);
+            }
+            nextLayer[word] |= cells;
+        }
+    };
+    for (int word : activeWords)
+    {
+        const std::uint64_t cells = layer[word];
+        spread(word, (cells << 1) | (cells >> 1));
+        spread(word - 1, cells << 63);
+        spread(word + 1, cells >> 63);
+        spread(word - rowWords, cells);
+        spread(word + rowWords, cells);
+    }
+
+    // Keep the open cells not visited yet
+    ++depth;
+    const int label = depth % 3;
+    nextActiveWords.clear();
+    for (int word : candidateWords)
+    {
+        const std::uint64_t reached = nextLayer[word] & open[word] & ~visited[word];
+        nextLayer[word] = reached;
+        if (reached == 0)
+        {
+            continue;
+        }
+        visited[word] |= reached;
+        if ((label & 1) != 0)
+        {
+            labelLow[word] |= reached;
+        }
+        if ((label & 2) != 0)
+        {
+            labelHigh[word] |= reached;
+        }
+        nextActiveWords.push_back(word);
+        nodesExploredCount += countSetBits(reached);
+
+        // Mark explored cells (not start/end) as "visited" for UI animation
+        if (markVisited)
+        {
+            const int firstCell = ((word / rowWords) * m_maze.getStride()) + ((word % rowWords) * 64);
+            for (std::uint64_t bits = reached; bits != 0; bits &= bits - 1)
+            {
+                const int cell = firstCell + lowestSetBit(bits);
+                if (m_maze.getCellType(cell) == CellType::Path)
+                {
+                    m_maze.setCellType(cell, CellType::Visited);
+                }
+            }
+        }
+    }
+
+    // The old layer is cleared word by word, so it can be reused for the layer after next
+    for (int word : activeWords)
+    {
+        layer[word] = 0;
+    }
+    layer.swap(nextLayer);
+    activeWords.swap(nextActiveWords);
+
+    std::uint64_t endMask;
+    return (visited[wordOf(endIndex, endMask)] & endMask) != 0;
+}
+
+const std::vector<Position> &BitboardBFS::reconstructPath()
+{
+    // end is in the current layer. Neighbors on a shortest path are exactly one layer apart, and of the three layers a
+    // visited neighbor can be in only the previous one has the previous label.
+    auto labelOf = [this](int index) {
+        std::uint64_t mask;
+        const int word = wordOf(index, mask);
+        if ((visited[word] & mask) == 0)
+        {
+            return -1;
+        }
+        return (((labelHigh[word] & mask) != 0) ? 2 : 0) | (((labelLow[word] & mask) != 0) ? 1 : 0);
+    };
+
+    int label = depth % 3;
+    for (int index = endIndex; index != startIndex;)
+    {
+        const int previous = (label + 2) % 3;
+        for (int i = 0; i < NUM_DIRECTIONS; ++i)
+        {
+            const int parent = index - neighborOffset[i];
+            if (labelOf(parent) == previous)
+            {
+                setCameFrom(index, i);
+                index = parent;
+                break;
+            }
+        }
+        label = previous;
+    }
+    return MazeSolver::reconstructPath();
+}
+
+LifelongPlanningAStar::LifelongPlanningAStar(Maze &maze, SolverWorkspace *workspace) : MazeSolver(maze, workspace)
+{
+    gScore.assign(maze.getCellCount(), UNREACHED);
+    rhs.assign(maze.getCellCount(), UNREACHED);
+    initializeSearch();
+}
+
+void LifelongPlanningAStar::initializeSearch()
+{
+    while (!openSet.empty())
+        openSet.pop();
+    rhs[startIndex] = 0;
+    openSet.push({calculateKey(startIndex), startIndex});
+}
+
+void LifelongPlanningAStar::reset()
+{
+    MazeSolver::reset();
+    std::fill(gScore.begin(), gScore.end(), UNREACHED);
+    std::fill(rhs.begin(), rhs.end(), UNREACHED);
+    initializeSearch();
+}
+
+long long LifelongPlanningAStar::calculateKey(int index) const
+{
+    const long long best = std::min(gScore[index], rhs[index]);
+    const int heuristic = manhattanDistance({m_maze.rowOf(index), m_maze.colOf(index)}, end);
+    return ((best + heuristic) << 32) | best;
+}
+
+void LifelongPlanningAStar::updateCell(int index)
+{
+    if (index != startIndex)
+    {
+        int best = UNREACHED;
+        if (m_maze.isPassable(index))
+        {
+            for (int offset : neighborOffset)
+            {
+                if (m_maze.isPassable(index + offset))
+                {
+                    best = std::min(best, gScore[index + offset] + 1);
+                }
+            }
+        }
+        rhs[index] = std::min(best, UNREACHED);
+    }
+
+    // The old entry of the cell, if any, no longer matches its key and is skipped when it reaches the top
+    if (gScore[index] != rhs[index])
+    {
+        openSet.push({calculateKey(index), index});
+    }
+}
+
+void LifelongPlanningAStar::notifyCellChanged(int row, int col)
+{
+    // Adding or removing a wall changes the steps between the cell and its four neighbors
+    const int index = m_maze.cellIndex(row, col);
+    updateCell(index);
+    for (int offset : neighborOffset)
+    {
+        if (m_maze.isPassable(index + offset))
+        {
+            updateCell(index + offset);
+        }
+    }
+}
+
+bool LifelongPlanningAStar::isSearchComplete()
+{
+    while (!openSet.empty())
+    {
+        const KeyedCell &top = openSet.top();
+        if (gScore[top.index] != rhs[top.index] && top.key == calculateKey(top.index))
+        {
+            break;
+        }
+        openSet.pop();
+    }
+    return gScore[endIndex] == rhs[endIndex] && (openSet.empty() || openSet.top().key >= calculateKey(endIndex));
+}
+
+const std::vector<Position> &LifelongPlanningAStar::solveMaze()
+{
+    nodesExplored = 0;
+    while (!isSearchComplete())
+    {
+        step(nodesExplored);
+    }
+    return reconstructPath(); // Mark the path on the maze, empty if end is not reachable
+}
+
+bool LifelongPlanningAStar::step(int &nodesExploredCount)
+{
+    // check if search is complete
+    if (isSearchComplete())
+    {
+        return gScore[endIndex] < UNREACHED;
+    }
+
+    const int current = openSet.top().index;
+    openSet.pop();
+    nodesExploredCount++;
+    if (gScore[current] > rhs[current])
+    {
+        // Overconsistent: the cell got a shorter path, settle it
+        gScore[current] = rhs[current];
+    }
+    else
+    {
+        // Underconsistent: the path the cell had is gone or got longer, so it has to be found again
+        gScore[current] = UNREACHED;
+        updateCell(current);
+    }
+    for (int offset : neighborOffset)
+    {
+        if (m_maze.isPassable(current + offset))
+        {
+            updateCell(current + offset);
+        }
+    }
+
+    // Mark expanded cells (not start/end) as "visited" for UI animation
+    if (m_maze.getCellType(current) == CellType::Path)
+    {
+        m_maze.setCellType(current, CellType::Visited);
+    }
+    return false; // Continue searching
+}
+
+bool LifelongPlanningAStar::isExhausted() const
+{
+    // isSearchComplete() drops the outdated entries, so the open set empties once the search has nowhere left to go
+    return openSet.empty() && gScore[endIndex] >= UNREACHED;
+}
+
+const std::vector<Position> &LifelongPlanningAStar::reconstructPath()
+{
+    if (gScore[endIndex] >= UNREACHED)
+    {
+        path.clear();
+        return path;
+    }
+
+    // Once the search is complete, the open neighbor with the smallest g-score lies on a shortest path back to start
+    // (walls may still hold the g-score they had before they were added)
+    for (int index = endIndex; index != startIndex;)
+    {
+        int bestDirection = -1;
+        for (int i = 0; i < NUM_DIRECTIONS; ++i)
+        {
+            const int neighbor = index - neighborOffset[i];
+            if (m_maze.isPassable(neighbor) && (bestDirection < 0 || gScore[neighbor] < gScore[index - neighborOffset[bestDirection]]))
+            {
+                bestDirection = i;
+            }
+        }
+        setCameFrom(index, bestDirection);
+        index -= neighborOffset[bestDirection];
+    }
+    return MazeSolver::reconstructPath();
+}
+
+void RadixHeap::clear()
+{
+    for (auto &bucket : buckets)
+    {
+        bucket.clear();
+    }
+    last = 0;
+    size = 0;
+}
+
+int RadixHeap::bucketOf(std::uint32_t key) const
+{
+    return (key == last) ? 0 : highestSetBit(key ^ last) + 1;
+}
+
+void RadixHeap::push(std::uint32_t key, int index)
+{
+    buckets[bucketOf(key)].emplace_back(key, index);
+    ++size;
+}
+
+int RadixHeap::pop(std::uint32_t &key)
+{
+    if (buckets[0].empty())
+    {
+        // Every key of the first non-empty bucket shares the bits above its bucket with the new minimum, so around that
+        // minimum they all land in lower buckets
+        int bucket = 1;
+        while (buckets[bucket].empty())
+        {
+            ++bucket;
+        }
+        last = std::min_element(buckets[bucket].begin(), buckets[bucket].end())->first;
+        for (const auto &entry : buckets[bucket])
+        {
+            buckets[bucketOf(entry.first)].push_back(entry);
+        }
+        buckets[bucket].clear();
+    }
+    const auto entry = buckets[0].back();
+    buckets[0].pop_back();
+    --size;
+    key = entry.first;
+    return entry.second;
+}
+
+DijkstraSearch::DijkstraSearch(Maze &maze, SolverWorkspace *workspace)
+    : MazeSolver(maze, workspace), openSet(this->workspace.getRadixHeap())
+{
+    reset();
+}
+
+void DijkstraSearch::reset()
+{
+    MazeSolver::reset();
+    // A new search number sets every cost to unset without touching them
+    workspace.beginSearch(m_maze.getCellCount());
+    openSet.clear();
+    workspace.setScore(0, startIndex, 0);
+    openSet.push(0, startIndex);
+}
+
+const std::vector<Position> &DijkstraSearch::solveMaze()
+{
+    nodesExplored = 0;
+    while (!openSet.empty())
+    {
+        if (step(nodesExplored))
+        {
+            return reconstructPath(); // Mark the path on the maze
+        }
+    }
+
+    path.clear();
+    return path; // No path found
+}
+
+bool DijkstraSearch::step(int &nodesExploredCount)
+{
+    // Pop the cheapest cell, skipping entries left behind by later improvements
+    int current;
+    std::uint32_t key;
+    do
+    {
+        if (openSet.empty())
+        {
+            return false; // No path found - all reachable cells settled
+        }
+        current = openSet.pop(key);
+    } while (static_cast<int>(key) != workspace.getScore(0, current));
+
+    if (current == endIndex)
+    {
+        return true; // Cheapest path found
+    }
+
+    for (int i = 0; i < NUM_DIRECTIONS; ++i)
+    {
+        const int next = current + neighborOffset[i];
+        if (!m_maze.isPassable(next))
+        {
+            continue;
+        }
+        nodesExploredCount++;
+        const std::uint32_t tentative = key + static_cast<std::uint32_t>(m_maze.getCost(next));
+        if (static_cast<int>(tentative) < workspace.getScore(0, next))
+        {
+            workspace.setScore(0, next, static_cast<int>(tentative));
+            setCameFrom(next, i);
+            openSet.push(tentative, next);
+
+            // Mark explored cells (not start/end) as "visited" for UI animation
+            if (m_maze.getCellType(next) == CellType::Path)
+            {
+                m_maze.setCellType(next, CellType::Visited);
+            }
+        }
+    }
+    return false;
+}
+
+bool DijkstraSearch::isExhausted() const
+{
+    return openSet.empty();
 }
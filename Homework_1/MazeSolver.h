@@ -8,16 +8,27 @@ This file uses sample code provided in PathfindingNotes.md and makes slight modi
 to implement the required functionality for Homework 1.
 The MazeSolver class is an abstract base class that defines the interface for maze solving algorithms.
 The BreadthFirstSearch and AStarSearch classes inherit from MazeSolver and implement the BFS and A* algorithms, respectively.
+BidirectionalBFS and BidirectionalAStar run the same searches from both ends at once and join them where they meet.
+ParallelBFS expands each BFS layer with OpenMP threads, switching between top-down and bottom-up layers.
+JumpPointSearch is A* that jumps along straight lines and only opens the cells where the path may have to turn.
+BitboardBFS runs BFS on bitmaps of the grid, expanding 64 cells of a layer with a few word operations.
+LifelongPlanningAStar keeps its search between solves and only repairs the part affected by cells that changed.
+DijkstraSearch finds the cheapest path over the terrain costs of the maze with a radix heap; AStarSearch reads them too.
+SolverWorkspace holds the scratch memory of the solvers, shared between them and kept between searches and mazes.
 */
 
 #ifndef HOMEWORK_1_MAZESOLVER_H_
 #define HOMEWORK_1_MAZESOLVER_H_
 
 #include "MazeGenerator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <list>
+#include <limits>
+#include <memory>
 #include <queue>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // Position in the maze
@@ -35,19 +46,10 @@ struct Position
     }
 };
 
-// For using Position as a key in unordered_map
-struct PositionHash
-{
-    size_t operator()(const Position &p) const
-    {
-        return std::hash<int>()(p.row) ^ (std::hash<int>()(p.col) << 16);
-    }
-};
-
 // Node structure for A* search
 struct Node
 {
-    Position pos;
+    int index; // Flat grid index of the cell (see Maze::cellIndex)
     int fScore;
 
     bool operator>(const Node &other) const
@@ -56,6 +58,247 @@ struct Node
     }
 };
 
+// @brief Open set implementations available to A*
+enum class OpenSetType
+{
+    BinaryHeap, // Binary heap ordered by f-score
+    BucketQueue // Buckets per f-score and heuristic, O(1) on unit-cost grids (see BucketOpenSet)
+};
+
+// @class BucketOpenSet
+// @brief A* open set for grids where every step costs 1 and the heuristic is the Manhattan distance
+// Each step changes g by 1 and h by 1, so a node reached from the node being expanded has the same f-score or one
+// that is 2 larger: the open set only ever holds two f-scores (three for the averaged keys of BidirectionalAStar,
+// which grow by 0, 2 or 4). Each of them keeps one stack of cells per heuristic value and pops the smallest
+// heuristic first, which breaks f-score ties toward the larger g (the node closest to the goal). Push is O(1) and
+// pop only scans forward over empty heuristic buckets.
+class BucketOpenSet
+{
+  public:
+    /**
+     * @brief Remove all entries and size the buckets for a maze
+     * @param maxHeuristic Largest heuristic value that will be pushed
+     */
+    void reset(int maxHeuristic);
+    /**
+     * @brief Check if the open set has no entries
+     */
+    bool empty() const
+    {
+        return size == 0;
+    }
+    /**
+     * @brief Get the number of entries, including outdated ones
+     */
+    int getSize() const
+    {
+        return size;
+    }
+    /**
+     * @brief Get the lowest f-score in the open set (only valid when it is not empty)
+     */
+    int lowestFScore() const
+    {
+        int fScore = currentF;
+        while (count[(fScore / 2) % LEVELS] == 0)
+        {
+            fScore += 2;
+        }
+        return fScore;
+    }
+    /**
+     * @brief Add a cell
+     * @param index Flat grid index of the cell
+     * @param fScore Non-negative f-score of the cell: the f-score last popped, 2 more or 4 more (any value with the same
+     * parity for the first push after reset())
+     * @param heuristic Heuristic value of the cell, at most the maxHeuristic given to reset()
+     */
+    void push(int index, int fScore, int heuristic);
+    /**
+     * @brief Remove the cell with the lowest f-score, breaking ties toward the lowest heuristic (largest g)
+     * @param fScore Receives the f-score the cell was pushed with
+     * @param heuristic Receives the heuristic value the cell was pushed with
+     * @return Flat grid index of the cell
+     */
+    int pop(int &fScore, int &heuristic);
+
+  private:
+    static constexpr int LEVELS = 3; // f-scores that can be open at the same time
+
+    std::vector<std::vector<int>> buckets[LEVELS]; // Per f-score level, one stack of cells per heuristic value
+    int count[LEVELS] = {};                        // Entries per level
+    int lowestHeuristic[LEVELS] = {};              // Lower bound on the smallest non-empty heuristic bucket per level
+    int currentF = 0;                              // f-score being popped, its level is (currentF / 2) % LEVELS
+    int size = 0;
+};
+
+// @class RadixHeap
+// @brief Monotone priority queue of flat grid indices for Dijkstra's algorithm
+// Keys never go below the key last popped, which holds for Dijkstra with non-negative costs. Bucket b > 0 holds the
+// keys whose highest bit that differs from the last popped key is bit b - 1, bucket 0 the keys equal to it. When
+// bucket 0 runs empty, the first non-empty bucket is spread over the lower buckets around its smallest key. An entry
+// only ever moves down, at most 32 times, so both push and pop are O(1) amortized.
+class RadixHeap
+{
+  public:
+    /**
+     * @brief Remove all entries and start again from key 0
+     */
+    void clear();
+    /**
+     * @brief Check if the heap has no entries
+     */
+    bool empty() const
+    {
+        return size == 0;
+    }
+    /**
+     * @brief Add a cell
+     * @param key Priority, not below the key last popped
+     * @param index Flat grid index of the cell
+     */
+    void push(std::uint32_t key, int index);
+    /**
+     * @brief Remove a cell with the smallest key (only valid when the heap is not empty)
+     * @param key Receives the key the cell was pushed with
+     * @return Flat grid index of the cell
+     */
+    int pop(std::uint32_t &key);
+
+  private:
+    static constexpr int BUCKETS = 33; // Key equal to the last popped one, then one per highest differing bit
+
+    std::vector<std::pair<std::uint32_t, int>> buckets[BUCKETS]; // (key, flat grid index) entries
+    std::uint32_t last = 0;                                      // Key last popped
+    int size = 0;
+
+    /**
+     * @brief Get the bucket of a key relative to the key last popped
+     */
+    int bucketOf(std::uint32_t key) const;
+};
+
+// @class SolverWorkspace
+// @brief Scratch memory of the solvers, shared by any number of them and kept between searches and mazes
+// Every array grows to the largest maze seen and is never shrunk. Each score array has a stamp per cell, the number of
+// the search that last reached it, and starting a search takes the next number, so every score of an earlier search
+// reads as unset without touching the array: a search only costs the cells it reaches. The stamps are a byte, as wide
+// as the visited arrays they replace, so a breadth-first search over the whole grid moves no more memory than before;
+// they are cleared once every 255 searches when the numbers run out. A solver given no workspace creates its own.
+// Solvers sharing one must not search at the same time, each reset() before searching again after another one
+// searched, and a path stays valid only until the next search of any of them.
+class SolverWorkspace
+{
+  public:
+    static constexpr int SIDES = 2;                               // Score arrays, trees and open sets: one per bidirectional search
+    static constexpr int QUEUES = 2 * SIDES;                      // Cell lists: a layer and the next one per side
+    static constexpr int UNSET = std::numeric_limits<int>::max(); // Score of a cell the current search has not reached
+
+    /**
+     * @brief Make room for a maze without starting a search
+     * @param cellCount Entries of the maze's flat grid (see Maze::getCellCount)
+     */
+    void reserve(int cellCount);
+    /**
+     * @brief Start a search of a maze: make room for it and mark every cell as not reached, in O(1) but for every 255th
+     * search
+     * @param cellCount Entries of the maze's flat grid
+     */
+    void beginSearch(int cellCount);
+
+    /**
+     * @brief Check if the current search reached a cell
+     * @param side Score array, below SIDES
+     * @param index Flat grid index of the cell
+     */
+    bool isReached(int side, int index) const
+    {
+        return stamps[side][index] == search;
+    }
+    /**
+     * @brief Mark a cell as reached without a score, for searches that only ask isReached()
+     */
+    void markReached(int side, int index)
+    {
+        stamps[side][index] = search;
+    }
+    /**
+     * @brief Get the score the current search gave a cell, UNSET if it was not reached
+     */
+    int getScore(int side, int index) const
+    {
+        return (stamps[side][index] == search) ? values[side][index] : UNSET;
+    }
+    /**
+     * @brief Mark a cell as reached with a score
+     */
+    void setScore(int side, int index, int value)
+    {
+        stamps[side][index] = search;
+        values[side][index] = value;
+    }
+
+    /**
+     * @brief Get a packed direction array, 2 bits per flat grid index (see MazeSolver::setCameFrom)
+     * Only cells reached by the current search are ever read back, so the trees are never cleared.
+     */
+    std::vector<std::uint8_t> &getTree(int side)
+    {
+        return trees[side];
+    }
+    /**
+     * @brief Get a list of flat grid indices, below QUEUES, left as the last search that used it left it
+     */
+    std::vector<int> &getQueue(int which)
+    {
+        return queues[which];
+    }
+    /**
+     * @brief Get the storage of a binary heap of nodes (see std::push_heap)
+     */
+    std::vector<Node> &getHeap()
+    {
+        return heap;
+    }
+    /**
+     * @brief Get a bucket open set, below SIDES
+     */
+    BucketOpenSet &getBucketOpenSet(int side)
+    {
+        return bucketOpenSets[side];
+    }
+    /**
+     * @brief Get the radix heap
+     */
+    RadixHeap &getRadixHeap()
+    {
+        return radixHeap;
+    }
+    /**
+     * @brief Get the path the solvers reconstruct into
+     */
+    std::vector<Position> &getPath()
+    {
+        return path;
+    }
+    /**
+     * @brief Get the bytes held by the score arrays, trees, queues, heap and path
+     */
+    std::size_t getMemoryUsage() const;
+
+  private:
+    std::vector<std::uint8_t> stamps[SIDES]; // Search that last reached each flat grid index
+    std::vector<int> values[SIDES];          // Score of each flat grid index, only meaningful with the current stamp
+    std::vector<std::uint8_t> trees[SIDES];  // Packed parent directions
+    std::vector<int> queues[QUEUES];
+    std::vector<Node> heap;
+    BucketOpenSet bucketOpenSets[SIDES];
+    RadixHeap radixHeap;
+    std::vector<Position> path;
+    std::uint8_t search = 0; // Number of the current search, never 0 so cleared stamps read as not reached
+    int capacity = 0;        // Flat grid entries the arrays hold
+};
+
 // @class MazeSolver
 // @brief Abstract base class for maze solving algorithms
 class MazeSolver
@@ -69,21 +312,109 @@ class MazeSolver
     Maze &m_maze;
     Position start;
     Position end;
-    Position terminator;
-    std::unordered_map<Position, Position, PositionHash> cameFrom;
+    int startIndex;                                  // Flat grid index of start
+    int endIndex;                                    // Flat grid index of end
+    int neighborOffset[NUM_DIRECTIONS];              // Flat grid offsets matching DIRECTION_ROW/DIRECTION_COL
+    std::unique_ptr<SolverWorkspace> ownedWorkspace; // Created when the solver was given no workspace
+    SolverWorkspace &workspace;                      // Scratch memory of the searches
+    std::vector<std::uint8_t> &cameFrom;             // 2 bits per flat grid index: direction of the step that reached the cell
+    std::vector<Position> &path;                     // Reconstructed path, its capacity is reused between searches
+    int nodesExplored;                               // Nodes explored by the last solveMaze()
+
+    /**
+     * @brief Record the direction of the step that reached a cell
+     * Only cells reached by the current search are ever read back, so the array is never cleared.
+     * @param index Flat grid index of the reached cell
+     * @param direction Index into DIRECTION_ROW/DIRECTION_COL
+     * @param tree Packed direction array to update (cameFrom, or a second tree of a bidirectional search)
+     */
+    static void setCameFrom(int index, int direction, std::vector<std::uint8_t> &tree)
+    {
+        std::uint8_t &packed = tree[index >> 2];
+        const int shift = (index & 3) * 2;
+        packed = static_cast<std::uint8_t>((packed & ~(3 << shift)) | (direction << shift));
+    }
+    void setCameFrom(int index, int direction)
+    {
+        setCameFrom(index, direction, cameFrom);
+    }
+
+    /**
+     * @brief Get the direction of the step that reached a cell
+     * @param index Flat grid index of a cell reached by the current search (other than the root of its tree)
+     * @param tree Packed direction array the cell was recorded in
+     * @return Index into DIRECTION_ROW/DIRECTION_COL
+     */
+    static int cameFromDirection(int index, const std::vector<std::uint8_t> &tree)
+    {
+        return (tree[index >> 2] >> ((index & 3) * 2)) & 3;
+    }
+
+    /**
+     * @brief Get the flat grid index of the cell a cell was reached from
+     * @param index Flat grid index of a cell reached by the current search (other than the root of its tree)
+     * @param tree Packed direction array the cell was recorded in
+     * @return Flat grid index of its parent
+     */
+    int parentOf(int index, const std::vector<std::uint8_t> &tree) const
+    {
+        return index - neighborOffset[cameFromDirection(index, tree)];
+    }
+    int parentOf(int index) const
+    {
+        return parentOf(index, cameFrom);
+    }
+
+    /**
+     * @brief Count the cells from a cell back to the root of its search tree, both included
+     * @param index Flat grid index of a cell reached by the current search
+     * @param root Flat grid index of the root of the tree (where the search started)
+     * @param tree Packed direction array of the tree
+     * @return Number of cells
+     */
+    std::size_t branchLength(int index, int root, const std::vector<std::uint8_t> &tree) const;
+
+    /**
+     * @brief Write the cells from a cell back to the root of its search tree into path
+     * Cells other than start and end are marked as solution for visualization.
+     * @param index Flat grid index of the first cell
+     * @param root Flat grid index of the root of the tree
+     * @param tree Packed direction array of the tree
+     * @param first Position in path of the first cell
+     * @param stride 1 to write the following cells toward the back of path, -1 toward the front
+     */
+    void writeBranch(int index, int root, const std::vector<std::uint8_t> &tree, std::ptrdiff_t first, int stride);
+
+    /**
+     * @brief Build the path of a bidirectional search from the cell where its two trees meet
+     * @param meeting Flat grid index of a cell reached by both searches
+     * @param fromStart Packed direction array of the search rooted at start
+     * @param fromEnd Packed direction array of the search rooted at end
+     * @return Positions from end back to start
+     */
+    const std::vector<Position> &joinBranches(int meeting, const std::vector<std::uint8_t> &fromStart,
+                                              const std::vector<std::uint8_t> &fromEnd);
+
+    /** @brief Manhattan distance heuristic for A* search
+     *  @param a First position
+     *  @param b Second position
+     *  @return Manhattan distance between a and b
+     */
+    static int manhattanDistance(Position a, Position b);
 
   public:
     /**
      * @brief Construct a new MazeSolver object
      * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
      */
-    explicit MazeSolver(Maze &maze);
+    explicit MazeSolver(Maze &maze, SolverWorkspace *workspace = nullptr);
     virtual ~MazeSolver() = default;
     /**
-     * @brief Solve the maze using the specific algorithm, returning the path from start to end as a list of positions
-     * @return List of positions representing the path from start to end (empty if no path found)
+     * @brief Solve the maze using the specific algorithm, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
      */
-    virtual std::list<Position> solveMaze() = 0;
+    virtual const std::vector<Position> &solveMaze() = 0;
     /**
      * @brief Perform one step of the algorithm, exploring the next node and updating the search state accordingly
      * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented when a node is
@@ -92,10 +423,22 @@ class MazeSolver
      */
     virtual bool step(int &nodesExploredCount) = 0;
     /**
-     * @brief Reconstruct the path from start to end after the search is complete
-     * @return List of positions representing the reconstructed path
+     * @brief Reconstruct the path after the search has reached the end, walking the parent directions back to start
+     * @return Positions from end back to start, valid until the next search
+     */
+    virtual const std::vector<Position> &reconstructPath();
+    /**
+     * @brief Get the number of nodes explored by the last call to solveMaze()
      */
-    virtual std::list<Position> reconstructPath();
+    int getNodesExplored() const
+    {
+        return nodesExplored;
+    }
+    /**
+     * @brief Check if the search explored every cell it can reach without reaching the end
+     * Once true, step() keeps returning false and there is no path to reconstruct.
+     */
+    virtual bool isExhausted() const = 0;
     /**
      * @brief Reset the solver to its initial state, clearing all data structures and reinitializing the start position
      */
@@ -110,13 +453,14 @@ class BreadthFirstSearch : public MazeSolver
     /**
      * @brief Construct a new BFS solver object
      * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
      */
-    explicit BreadthFirstSearch(Maze &maze);
+    explicit BreadthFirstSearch(Maze &maze, SolverWorkspace *workspace = nullptr);
     /**
-     * @brief Solve the maze using breadth-first search, returning the path from start to end as a list of positions
-     * @return List of positions representing the path from start to end (empty if no path found)
+     * @brief Solve the maze using breadth-first search, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
      */
-    std::list<Position> solveMaze() override;
+    const std::vector<Position> &solveMaze() override;
     /**
      * @brief Perform one step of the BFS algorithm, exploring the next node in the frontier and updating the search state accordingly
      * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented when a node is
@@ -124,6 +468,10 @@ class BreadthFirstSearch : public MazeSolver
      * @return true if the goal has been reached and the path can be reconstructed
      */
     bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if the frontier ran out without reaching the end
+     */
+    bool isExhausted() const override;
     /**
      * @brief Reset the BFS solver to its initial state, clearing all data structures and reinitializing the frontier with the start
      * position
@@ -131,26 +479,31 @@ class BreadthFirstSearch : public MazeSolver
     void reset() override;
 
   private:
-    std::queue<Position> frontier;
-    std::vector<std::vector<bool>> visited;
+    std::vector<int> &frontier; // Flat grid indices in the order they were reached, marked as reached in the workspace
+    std::size_t head;           // Next cell of frontier to expand
 };
 
 // @class AStarSearch
 // @brief Implements A* algorithm for maze solving
+// On a maze with terrain each step costs the terrain cost of the cell it enters, and the Manhattan distance is scaled by
+// the lowest cost so it never overestimates. Steps of different costs break the two f-scores the bucket queue relies on,
+// so such mazes always use the binary heap.
 class AStarSearch : public MazeSolver
 {
   public:
     /**
      * @brief Construct a new A* solver object
      * @param maze Reference to the maze to be solved
+     * @param type Open set implementation (the bucket queue unless comparing against the binary heap)
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
      */
-    explicit AStarSearch(Maze &maze);
+    explicit AStarSearch(Maze &maze, OpenSetType type = OpenSetType::BucketQueue, SolverWorkspace *workspace = nullptr);
 
     /**
-     * @brief Solve the maze using A* algorithm, returning the path from start to end as a list of positions
-     * @return List of positions representing the path from start to end (empty if no path found)
+     * @brief Solve the maze using A* algorithm, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
      */
-    std::list<Position> solveMaze() override;
+    const std::vector<Position> &solveMaze() override;
     /**
      * @brief Perform one step of the A* algorithm, exploring the next node in the open set and updating the search state accordingly
      * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented when a node is
@@ -158,6 +511,10 @@ class AStarSearch : public MazeSolver
      * @return true if the goal has been reached and the path can be reconstructed
      */
     bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if the open set ran empty without reaching the end
+     */
+    bool isExhausted() const override;
 
     /**
      * @brief Reset the A* solver to its initial state, clearing all data structures and reinitializing the open set with the start position
@@ -165,16 +522,538 @@ class AStarSearch : public MazeSolver
     void reset() override;
 
   private:
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
-    std::vector<std::vector<int>> gScore;
-    std::vector<std::vector<bool>> inOpenSet;
+    OpenSetType openSetType;
+    bool weighted;                // The maze had terrain at the last reset
+    int heuristicScale;           // Lowest terrain cost, 1 without terrain
+    std::vector<Node> &openSet;   // Binary heap ordered by f-score, used by OpenSetType::BinaryHeap
+    BucketOpenSet &bucketOpenSet; // Used by OpenSetType::BucketQueue
 
-    /** @brief Manhattan distance heuristic for A* search
-     *  @param a First position
-     *  @param b Second position
-     *  @return Manhattan distance between a and b
+    /**
+     * @brief Check if the bucket queue is in use: it was asked for and every step costs 1
      */
-    static int manhattanDistance(Position a, Position b);
+    bool usesBuckets() const
+    {
+        return openSetType == OpenSetType::BucketQueue && !weighted;
+    }
+    /**
+     * @brief Get the heuristic value of a cell, the scaled Manhattan distance to end
+     */
+    int heuristicOf(Position position) const
+    {
+        return heuristicScale * manhattanDistance(position, end);
+    }
+    /**
+     * @brief Check if the active open set has no entries
+     */
+    bool isOpenSetEmpty() const;
+    /**
+     * @brief Clear the open sets and add the start position
+     */
+    void initializeOpenSet();
+};
+
+// @class BidirectionalBFS
+// @brief Breadth-first search from start and end at the same time, meeting in the middle
+// Each step expands one cell of the smaller frontier. Frontiers are expanded a whole layer at a time, and once the
+// searches touch the layer is finished so the shortest of the meeting points found in it is used.
+class BidirectionalBFS : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new bidirectional BFS solver object
+     * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
+     */
+    explicit BidirectionalBFS(Maze &maze, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Solve the maze with both searches, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Expand one cell of the active frontier
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented when a node is
+     * processed)
+     * @return true if the searches have met and the path can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if either search has run out of cells without meeting the other, so start and end are not connected
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Join the branch from start and the branch from end at the meeting point
+     * @return Positions from end back to start, valid until the next search
+     */
+    const std::vector<Position> &reconstructPath() override;
+    /**
+     * @brief Reset both searches to their roots
+     */
+    void reset() override;
+
+  private:
+    // One search direction: the layer being expanded and the layer it discovers, both workspace queues. Its steps from
+    // the root are the workspace scores and its parent directions the workspace tree of the same side.
+    struct Side
+    {
+        std::vector<int> *layer;
+        std::vector<int> *nextLayer;
+        std::size_t position; // Next cell of layer to expand
+    };
+
+    Side sides[2];  // Searches from start (0) and from end (1)
+    int active;     // Side whose layer is being expanded
+    int bestLength; // Shortest meeting found so far in steps, -1 before the searches meet
+    int meeting;    // Flat grid index where the best meeting joins both trees
+
+    /**
+     * @brief Clear both searches and seed them with start and end
+     */
+    void initializeSides();
+};
+
+// @class BidirectionalAStar
+// @brief A* from start toward end and from end toward start at the same time
+// Both searches use the average of the Manhattan distance to their goal and the negated distance to their root as
+// heuristic. These potentials are consistent and sum to zero, so the searches agree on the reduced cost of every step
+// and can stop as soon as the lowest keys of both open sets add up to the best path found (the bidirectional Dijkstra
+// rule); with the plain Manhattan distance each side would have to prove the bound on its own. Each step expands the
+// side with fewer open entries; whenever a cell has been reached by both searches the joined path is a candidate.
+class BidirectionalAStar : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new bidirectional A* solver object
+     * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
+     */
+    explicit BidirectionalAStar(Maze &maze, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Solve the maze with both searches, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Expand the best cell of one of the searches
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented when a node is
+     * processed)
+     * @return true if the shortest path is known and can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if either open set ran empty without the searches meeting, so start and end are not connected
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Join the branch from start and the branch from end at the meeting point
+     * @return Positions from end back to start, valid until the next search
+     */
+    const std::vector<Position> &reconstructPath() override;
+    /**
+     * @brief Reset both searches to their roots
+     */
+    void reset() override;
+
+  private:
+    // One search direction, its g-scores are the workspace scores and its parent directions the workspace tree of the
+    // same side
+    struct Side
+    {
+        BucketOpenSet *openSet;
+        Position root; // Where the search starts
+        Position goal; // Where the search heads
+    };
+
+    Side sides[2];  // Searches from start (0) and from end (1)
+    int bestLength; // Shortest meeting found so far in steps, INT_MAX before the searches meet
+    int meeting;    // Flat grid index where the best meeting joins both trees
+
+    /**
+     * @brief Clear both searches and seed them with start and end
+     */
+    void initializeSides();
+    /**
+     * @brief Get the potential of a cell for one side, the open set key of a cell is 2 * g + potential
+     * @param side The search
+     * @param position The cell
+     * @return Potential between 0 and twice the start-end distance
+     */
+    int potential(const Side &side, Position position) const;
+};
+
+// @class ParallelBFS
+// @brief Level-synchronous breadth-first search expanding each layer with OpenMP threads
+// Small layers are expanded top-down: each thread takes a share of the layer and claims unvisited neighbors with an
+// atomic fetch_or on the visited bitmap, collecting them in its own frontier buffer. Once the layer holds a large part
+// of the cells still unexplored it switches to bottom-up: each thread scans whole words of the visited bitmap and keeps
+// the unvisited cells that have a neighbor in the layer, which needs no atomics and stops at the first such neighbor.
+// Layers are exact, so the path has the same length as the one BreadthFirstSearch finds.
+class ParallelBFS : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new parallel BFS solver object
+     * @param maze Reference to the maze to be solved
+     * @param threadCount Threads expanding each layer (0 = the OpenMP default)
+     * @param workspace Scratch memory holding the parent directions and the path, shared with other solvers (nullptr to
+     * create one for this solver)
+     */
+    explicit ParallelBFS(Maze &maze, int threadCount = 0, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Solve the maze one layer at a time, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Expand the whole current layer in parallel
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented by the size of the
+     * new layer)
+     * @return true if the new layer holds the goal and the path can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if the last layer found no new cells without reaching the end
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Pack the parent directions of the path and walk them back to start
+     * @return Positions from end back to start, valid until the next search
+     */
+    const std::vector<Position> &reconstructPath() override;
+    /**
+     * @brief Rebuild the visited bitmap from the maze and reinitialize the frontier with the start position
+     */
+    void reset() override;
+    /**
+     * @brief Get the number of threads expanding each layer
+     */
+    int getNumThreads() const
+    {
+        return numThreads;
+    }
+    /**
+     * @brief Get the number of layers expanded bottom-up by the last search
+     */
+    int getBottomUpLayers() const
+    {
+        return bottomUpLayers;
+    }
+
+  private:
+    int numThreads;
+    std::vector<std::atomic<std::uint64_t>> visited; // 1 bit per flat grid index, walls and padding bits start set
+    std::vector<std::uint8_t> direction;             // Parent direction per flat grid index, a byte so threads never share one
+    std::vector<int> frontier;                       // Layer being expanded
+    std::vector<int> nextFrontier;                   // Layer it discovers, gathered from threadFrontiers
+    std::vector<std::vector<int>> threadFrontiers;   // Cells each thread discovered in the current layer
+    std::vector<std::size_t> threadOffsets;          // Where each thread's cells go in nextFrontier
+    std::vector<std::uint64_t> frontierBits;         // Layer being expanded as a bitmap (bottom-up only)
+    std::vector<std::uint64_t> nextFrontierBits;     // Layer discovered bottom-up as a bitmap
+    std::size_t passableCells;                       // Cells that are not walls
+    std::size_t unexplored;                          // Passable cells not reached yet
+    std::size_t previousFrontier;                    // Size of the layer expanded before the current one
+    bool bottomUp;                                   // Direction of the next layer
+    int bottomUpLayers;                              // Layers of the current search expanded bottom-up
+
+    /**
+     * @brief Build the visited bitmap from the maze and seed the frontier with start
+     */
+    void initializeSearch();
+    /**
+     * @brief Expand the current layer from its cells toward their unvisited neighbors
+     */
+    void expandTopDown();
+    /**
+     * @brief Expand the current layer from the unvisited cells toward the layer
+     */
+    void expandBottomUp();
+    /**
+     * @brief Move the cells of every thread buffer into nextFrontier (called by all threads of a parallel region)
+     */
+    void gatherThreadFrontiers();
+    /**
+     * @brief Pick the direction of the next layer from the sizes of the layer and of the unexplored part of the maze
+     */
+    void chooseDirection();
+};
+
+// @class JumpPointSearch
+// @brief A* over jump points for 4-connected grids
+// Straight runs through open areas have many equally short orderings of the same moves, which plain A* all opens.
+// Jump point search keeps one canonical ordering: from a cell it only continues straight or turns, and instead of
+// adding each neighbor it jumps in that direction until it reaches the goal or a jump point, a cell where a blocked
+// cell behind it makes a turn necessary (a forced neighbor). Vertical jumps also stop where a horizontal jump from
+// the cell would find a jump point. Only jump points enter the open set; the cells skipped in between are filled in
+// when the path is reconstructed.
+class JumpPointSearch : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new jump point search solver object
+     * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
+     */
+    explicit JumpPointSearch(Maze &maze, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Solve the maze with jump point search, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Expand the jump point with the lowest f-score, jumping in each direction that is not pruned
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented for every jump
+     * point found)
+     * @return true if the goal has been reached and the path can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if the open set ran out of jump points without reaching the end
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Fill in the cells between consecutive jump points and walk the path back to start
+     * @return Positions from end back to start, valid until the next search
+     */
+    const std::vector<Position> &reconstructPath() override;
+    /**
+     * @brief Reset the solver to its initial state, clearing the open set and reinitializing it with the start position
+     */
+    void reset() override;
+    /**
+     * @brief Get the number of cells the jumps of the last search passed over, jump points included
+     */
+    long long getCellsScanned() const
+    {
+        return cellsScanned;
+    }
+
+  private:
+    std::vector<Node> &openSet; // Binary heap of jump points by f-score, g-scores are the workspace scores
+    long long cellsScanned;     // Cells passed over by jumps
+
+    /**
+     * @brief Clear the open set and add the start position
+     */
+    void initializeOpenSet();
+    /**
+     * @brief Move left or right from a cell until reaching a jump point
+     * @param index Flat grid index of the first cell of the jump
+     * @param offset -1 or 1
+     * @return Flat grid index of the jump point, -1 if a wall comes first
+     */
+    int jumpHorizontal(int index, int offset);
+    /**
+     * @brief Move up or down from a cell until reaching a jump point
+     * @param index Flat grid index of the first cell of the jump
+     * @param offset Minus or plus the grid stride
+     * @return Flat grid index of the jump point, -1 if a wall comes first
+     */
+    int jumpVertical(int index, int offset);
+};
+
+// @class BitboardBFS
+// @brief Breadth-first search on bitmaps, 64 cells per word
+// The open cells, the visited cells and the current layer are bitmaps with one row of 64-bit words per grid row, so
+// the neighbors of a whole word of the layer are its shifts left and right (with the carry from the adjacent words)
+// and the same word of the rows above and below. The next layer is that union, masked with the open cells not
+// visited yet. Only the words next to a non-empty word of the layer are touched, so the sparse layers of corridors
+// cost about as much as a scalar BFS while dense rows of open areas are expanded 64 cells at a time. Each cell keeps
+// its layer number modulo 3 in two more bitmaps, which is enough to walk back from end: the neighbor one layer closer
+// is the only one with the previous label.
+class BitboardBFS : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new bitboard BFS solver object
+     * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory holding the parent directions and the path, shared with other solvers (nullptr to
+     * create one for this solver)
+     */
+    explicit BitboardBFS(Maze &maze, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Solve the maze one layer at a time, returning the path between end and start
+     * Cells are not marked as visited, which would cost a step per cell instead of per word.
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Expand the whole current layer and mark its cells as visited for the UI
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented by the size of the
+     * new layer)
+     * @return true if the new layer holds the goal and the path can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if the last layer found no new cells without reaching the end
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Walk the layer labels back from end to start
+     * @return Positions from end back to start, valid until the next search
+     */
+    const std::vector<Position> &reconstructPath() override;
+    /**
+     * @brief Rebuild the open cell bitmap from the maze and reinitialize the layer with the start position
+     */
+    void reset() override;
+
+  private:
+    int rowWords;                         // 64-bit words per grid row, the border columns included
+    std::vector<std::uint64_t> open;      // Cells that are not walls
+    std::vector<std::uint64_t> visited;   // Cells reached so far
+    std::vector<std::uint64_t> layer;     // Cells of the current layer
+    std::vector<std::uint64_t> nextLayer; // Cells of the layer being computed, all zero in between
+    std::vector<std::uint64_t> labelLow;  // Bit 0 of the layer number modulo 3 of each visited cell
+    std::vector<std::uint64_t> labelHigh; // Bit 1 of the layer number modulo 3 of each visited cell
+    std::vector<int> activeWords;         // Non-empty words of layer
+    std::vector<int> nextActiveWords;     // Non-empty words of nextLayer
+    std::vector<int> candidateWords;      // Words of nextLayer the current layer spread into
+    int depth;                            // Layer number of the current layer
+
+    /**
+     * @brief Clear the bitmaps and seed the first layer with start
+     */
+    void initializeLayers();
+    /**
+     * @brief Compute the next layer and make it the current one
+     * @param markVisited Mark the cells of the new layer as visited for UI animation
+     * @param nodesExploredCount Incremented by the size of the new layer
+     * @return true if the new layer holds the goal
+     */
+    bool expandLayer(bool markVisited, int &nodesExploredCount);
+    /**
+     * @brief Get the word and bit of a flat grid index
+     * @param index Flat grid index
+     * @param mask Receives the bit of the cell in its word
+     * @return Word index in the bitmaps
+     */
+    int wordOf(int index, std::uint64_t &mask) const;
+};
+
+// @class LifelongPlanningAStar
+// @brief Incremental A* (LPA*) that repairs its search after walls are added or removed
+// Every cell keeps its g-score and an rhs value, one step more than the best g-score of its open neighbors (0 at
+// start). A cell whose two values differ is inconsistent and waits in the open set, keyed by [min(g, rhs) + h,
+// min(g, rhs)]. Expanding an overconsistent cell (g > rhs) settles it like A* does; expanding an underconsistent one
+// (g < rhs, its old path got longer) raises it to infinity so its neighbors look for another parent. The search stops
+// once end is consistent and no open key is smaller than its own. After cells change, notifyCellChanged() updates
+// only the rhs of those cells and their neighbors, so the next solveMaze() expands the cells whose distance changed
+// instead of searching again. With no changes the first search expands the same cells as A*.
+class LifelongPlanningAStar : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new LPA* solver object
+     * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory holding the parent directions and the path, shared with other solvers (nullptr to
+     * create one for this solver)
+     */
+    explicit LifelongPlanningAStar(Maze &maze, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Search, or repair the last search after cells changed, returning the path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Expand the inconsistent cell with the smallest key
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented when a node is
+     * processed)
+     * @return true if the search is complete and found a path that can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if the open set ran empty and the end still has no path
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Walk back from end through the neighbor with the smallest g-score
+     * @return Positions from end back to start, valid until the next search
+     */
+    const std::vector<Position> &reconstructPath() override;
+    /**
+     * @brief Forget the search and start over from start, as if the solver had just been created
+     */
+    void reset() override;
+    /**
+     * @brief Tell the solver that a cell turned into a wall or stopped being one
+     * Call it after Maze::setCellType for every cell that changed; start and end must stay open.
+     * @param row Row of the cell
+     * @param col Column of the cell
+     */
+    void notifyCellChanged(int row, int col);
+
+  private:
+    // Open set entry: the key packed as (min(g, rhs) + h) << 32 | min(g, rhs), compared as one number
+    struct KeyedCell
+    {
+        long long key;
+        int index;
+
+        bool operator>(const KeyedCell &other) const
+        {
+            return key > other.key;
+        }
+    };
+
+    std::priority_queue<KeyedCell, std::vector<KeyedCell>, std::greater<KeyedCell>> openSet; // Entries whose key changed are skipped
+    std::vector<int> gScore;                                                                  // Indexed by flat grid index
+    std::vector<int> rhs;                                                                     // Indexed by flat grid index
+
+    /**
+     * @brief Set every cell to unreached and add start to the open set
+     */
+    void initializeSearch();
+    /**
+     * @brief Get the open set key of a cell from its current g-score and rhs
+     */
+    long long calculateKey(int index) const;
+    /**
+     * @brief Recompute the rhs of a cell from its neighbors and add it to the open set if it is inconsistent
+     */
+    void updateCell(int index);
+    /**
+     * @brief Drop outdated entries from the top of the open set and check if the search is complete
+     * @return true if end is consistent and no inconsistent cell has a smaller key
+     */
+    bool isSearchComplete();
+};
+
+// @class DijkstraSearch
+// @brief Dijkstra's algorithm over the terrain costs of the maze, popping cells from a radix heap
+// Each step costs the terrain cost of the cell it enters (1 everywhere on a maze without terrain), so the path found
+// is the cheapest rather than the shortest. A cell whose cost improves is pushed again and its outdated entry skipped.
+class DijkstraSearch : public MazeSolver
+{
+  public:
+    /**
+     * @brief Construct a new Dijkstra solver object
+     * @param maze Reference to the maze to be solved
+     * @param workspace Scratch memory to search in, shared with other solvers (nullptr to create one for this solver)
+     */
+    explicit DijkstraSearch(Maze &maze, SolverWorkspace *workspace = nullptr);
+    /**
+     * @brief Solve the maze with Dijkstra's algorithm, returning the cheapest path between end and start
+     * @return Positions from end back to start (empty if no path found), valid until the next search
+     */
+    const std::vector<Position> &solveMaze() override;
+    /**
+     * @brief Settle the cheapest cell of the open set and relax its neighbors
+     * @param nodesExploredCount Reference to the integer counting the number of nodes explored so far (incremented for
+     * every passable neighbor looked at)
+     * @return true if the goal has been reached and the path can be reconstructed
+     */
+    bool step(int &nodesExploredCount) override;
+    /**
+     * @brief Check if every reachable cell was settled without reaching the end
+     */
+    bool isExhausted() const override;
+    /**
+     * @brief Reset the Dijkstra solver to its initial state, with only the start in the open set
+     */
+    void reset() override;
+
+  private:
+    RadixHeap &openSet; // Cheapest known costs from start are the workspace scores
 };
 
 #endif // HOMEWORK_1_MAZESOLVER_H_
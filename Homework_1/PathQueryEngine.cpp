@@ -0,0 +1,217 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file PathQueryEngine.cpp
+ * @brief Implementation of the batched path query engine
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "PathQueryEngine.h"
+#include <algorithm>
+#include <omp.h>
+#include <vector>
+
+#define PARENT_MASK 0x07 // Bits of a scratch cell holding the parent direction + 1
+#define START_CELL 0x05  // Parent value of the start of a search
+#define GOAL_CELL 0x08   // Flag of a scratch cell that is the goal of a query of the search
+
+PathQueryEngine::PathQueryEngine(const Maze &maze, int threadCount)
+    : m_maze(maze), m_num_threads((threadCount > 0) ? threadCount : omp_get_max_threads()),
+      m_neighbor_offset{-maze.getStride(), maze.getStride(), -1, 1}, m_scratch(m_num_threads)
+{
+}
+
+int PathQueryEngine::openIndex(Position position) const
+{
+    if (!m_maze.isInBounds(position.row, position.col))
+    {
+        return -1;
+    }
+    const int index = m_maze.cellIndex(position.row, position.col);
+    return m_maze.isPassable(index) ? index : -1;
+}
+
+void PathQueryEngine::run(const std::vector<PathQuery> &queries, PathQueryResults &results, bool withPaths)
+{
+    const int queryCount = static_cast<int>(queries.size());
+    results.lengths.assign(queryCount, -1);
+    results.pathOffsets.clear();
+    results.paths.clear();
+
+    // Sorting on start index then query number groups the queries of each start and keeps them in order within a group
+    m_order.clear();
+    for (int query = 0; query < queryCount; ++query)
+    {
+        const int start = openIndex(queries[query].start);
+        if (start >= 0)
+        {
+            m_order.push_back((static_cast<long long>(start) << 32) | query);
+        }
+    }
+    std::sort(m_order.begin(), m_order.end());
+    m_group_begin.clear();
+    for (std::size_t i = 0; i < m_order.size(); ++i)
+    {
+        if (i == 0 || (m_order[i] >> 32) != (m_order[i - 1] >> 32))
+        {
+            m_group_begin.push_back(static_cast<int>(i));
+        }
+    }
+    m_search_count = static_cast<int>(m_group_begin.size());
+    m_group_begin.push_back(static_cast<int>(m_order.size()));
+    if (withPaths)
+    {
+        m_path_thread.assign(queryCount, -1);
+        m_path_offset.resize(queryCount);
+    }
+
+    // Groups differ a lot in how far their search runs, so threads take them one at a time
+    const std::size_t cellCount = static_cast<std::size_t>(m_maze.getCellCount());
+#pragma omp parallel num_threads(m_num_threads)
+    {
+        const int thread = omp_get_thread_num();
+        Scratch &scratch = m_scratch[thread];
+        if (scratch.cells.size() != cellCount)
+        {
+            scratch.cells.assign(cellCount, 0);
+            scratch.distance.resize(cellCount);
+            scratch.queue.reserve(cellCount);
+        }
+        scratch.paths.clear();
+        scratch.nodesExplored = 0;
+
+#pragma omp for schedule(dynamic, 1)
+        for (int group = 0; group < m_search_count; ++group)
+        {
+            searchGroup(m_group_begin[group], m_group_begin[group + 1], queries, results, withPaths, thread);
+        }
+    }
+
+    m_nodes_explored = 0;
+    for (const Scratch &scratch : m_scratch)
+    {
+        m_nodes_explored += scratch.nodesExplored;
+    }
+    if (!withPaths)
+    {
+        return;
+    }
+
+    // Gather the paths of all threads into one array in query order
+    results.pathOffsets.resize(queryCount + 1);
+    results.pathOffsets[0] = 0;
+    for (int query = 0; query < queryCount; ++query)
+    {
+        results.pathOffsets[query + 1] = results.pathOffsets[query] + ((results.lengths[query] >= 0) ? results.lengths[query] + 1u : 0u);
+    }
+    results.paths.resize(results.pathOffsets[queryCount]);
+    for (int query = 0; query < queryCount; ++query)
+    {
+        if (m_path_thread[query] >= 0)
+        {
+            const std::vector<Position> &paths = m_scratch[m_path_thread[query]].paths;
+            const Position *path = paths.data() + m_path_offset[query];
+            std::copy(path, path + results.lengths[query] + 1, results.paths.begin() + results.pathOffsets[query]);
+        }
+    }
+}
+
+void PathQueryEngine::searchGroup(int begin, int end, const std::vector<PathQuery> &queries, PathQueryResults &results,
+                                  bool withPaths, int thread)
+{
+    Scratch &scratch = m_scratch[thread];
+    std::vector<std::uint8_t> &cells = scratch.cells;
+    std::vector<int> &distance = scratch.distance;
+    std::vector<int> &queue = scratch.queue;
+
+    // Flag the distinct goals so the search can stop once the last one is reached
+    int remaining = 0;
+    for (int i = begin; i < end; ++i)
+    {
+        const int goal = openIndex(queries[static_cast<int>(m_order[i] & 0xFFFFFFFF)].goal);
+        if (goal >= 0 && (cells[goal] & GOAL_CELL) == 0)
+        {
+            cells[goal] |= GOAL_CELL;
+            ++remaining;
+        }
+    }
+
+    // Breadth-first search one layer at a time, so the depth of the layer is the distance of every goal it reaches
+    auto reach = [&](int index, std::uint8_t parent, int steps) {
+        if ((cells[index] & GOAL_CELL) != 0)
+        {
+            distance[index] = steps;
+            --remaining;
+        }
+        cells[index] |= parent;
+        queue.push_back(index);
+    };
+    queue.clear();
+    reach(static_cast<int>(m_order[begin] >> 32), START_CELL, 0);
+    std::size_t layerEnd = 1;
+    int depth = 0;
+    for (std::size_t head = 0; remaining > 0 && head < queue.size(); ++head)
+    {
+        if (head == layerEnd)
+        {
+            layerEnd = queue.size();
+            ++depth;
+        }
+        const int current = queue[head];
+        ++scratch.nodesExplored;
+        for (int direction = 0; direction < 4; ++direction)
+        {
+            const int neighbor = current + m_neighbor_offset[direction];
+            if (m_maze.isPassable(neighbor) && (cells[neighbor] & PARENT_MASK) == 0)
+            {
+                reach(neighbor, static_cast<std::uint8_t>((direction ^ 1) + 1), depth + 1);
+            }
+        }
+    }
+
+    for (int i = begin; i < end; ++i)
+    {
+        const int query = static_cast<int>(m_order[i] & 0xFFFFFFFF);
+        const int goal = openIndex(queries[query].goal);
+        if (goal < 0 || (cells[goal] & PARENT_MASK) == 0)
+        {
+            continue;
+        }
+        const int length = distance[goal];
+        results.lengths[query] = length;
+        if (!withPaths)
+        {
+            continue;
+        }
+
+        // Follow the parent directions back from the goal, filling the path from its end
+        m_path_thread[query] = thread;
+        m_path_offset[query] = scratch.paths.size();
+        scratch.paths.resize(scratch.paths.size() + length + 1);
+        Position *path = scratch.paths.data() + m_path_offset[query];
+        int current = goal;
+        for (int steps = length; steps > 0; --steps)
+        {
+            path[steps] = {m_maze.rowOf(current), m_maze.colOf(current)};
+            current += m_neighbor_offset[(cells[current] & PARENT_MASK) - 1];
+        }
+        path[0] = {m_maze.rowOf(current), m_maze.colOf(current)};
+    }
+
+    // Leave the buffer clean for the next search: reached cells are in the queue, unreached goals are flagged
+    for (int index : queue)
+    {
+        cells[index] = 0;
+    }
+    for (int i = begin; i < end; ++i)
+    {
+        const int goal = openIndex(queries[static_cast<int>(m_order[i] & 0xFFFFFFFF)].goal);
+        if (goal >= 0)
+        {
+            cells[goal] = 0;
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file PathQueryEngine.h
+ * @brief Shortest paths for many (start, goal) pairs of one maze at once
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A MazeSolver answers the one start-end pair placed on its maze and allocates its buffers in
+ * its constructor. The engine instead takes a batch of queries, groups them by start cell and
+ * runs one breadth-first search per distinct start, which stops as soon as every goal of its
+ * group is reached. The groups are spread over OpenMP threads, each with its own scratch
+ * buffers that are allocated once and kept between batches. A search resets only the cells it
+ * reached, so one that stops early costs what it touched rather than the size of the maze.
+ */
+
+#ifndef HOMEWORK_1_PATHQUERYENGINE_H_
+#define HOMEWORK_1_PATHQUERYENGINE_H_
+
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief One shortest path query
+ */
+struct PathQuery
+{
+    Position start;
+    Position goal;
+};
+
+/**
+ * @brief Answers of a batch of queries in flat arrays, in the order of the queries
+ */
+struct PathQueryResults
+{
+    std::vector<int> lengths;             // Steps from start to goal, -1 if either is a wall or they are not connected
+    std::vector<std::size_t> pathOffsets; // Path of query i is paths[pathOffsets[i]] to paths[pathOffsets[i + 1] - 1] (only with paths)
+    std::vector<Position> paths;          // Cells of every path from start to goal, both included, back to back (only with paths)
+};
+
+/**
+ * @class PathQueryEngine
+ * @brief Batched breadth-first searches sharing per-thread scratch buffers
+ *
+ * The engine reads the maze on every batch, so walls may change between batches but not
+ * during one.
+ */
+class PathQueryEngine
+{
+  public:
+    /**
+     * @brief Create an engine for a maze
+     * @param maze The maze the queries refer to
+     * @param threadCount Number of OpenMP threads, 0 to use omp_get_max_threads()
+     */
+    explicit PathQueryEngine(const Maze &maze, int threadCount = 0);
+
+    /**
+     * @brief Answer a batch of queries
+     * @param queries The (start, goal) pairs; queries sharing a start are answered by the same search
+     * @param results Receives the answers; its vectors are resized and their capacity is reused
+     * @param withPaths Also write the cells of every path, not only the lengths
+     */
+    void run(const std::vector<PathQuery> &queries, PathQueryResults &results, bool withPaths = false);
+
+    /**
+     * @brief Get the number of threads the searches run on
+     */
+    int getNumThreads() const
+    {
+        return m_num_threads;
+    }
+    /**
+     * @brief Get the number of searches the last batch ran, one per distinct open start cell
+     */
+    int getSearchCount() const
+    {
+        return m_search_count;
+    }
+    /**
+     * @brief Get the number of cells the searches of the last batch dequeued
+     */
+    long long getNodesExplored() const
+    {
+        return m_nodes_explored;
+    }
+
+  private:
+    // Buffers of one thread, sized to the maze on first use
+    struct Scratch
+    {
+        std::vector<std::uint8_t> cells; // Per flat grid index: parent direction + 1 (START_CELL, 0 if not reached) | GOAL_CELL
+        std::vector<int> distance;       // Per flat grid index: steps from the start, only written for goals
+        std::vector<int> queue;          // Cells of the search in the order they are reached
+        std::vector<Position> paths;     // Paths found by this thread, back to back
+        long long nodesExplored = 0;     // Cells dequeued in the current batch
+    };
+
+    const Maze &m_maze;
+    int m_num_threads;
+    int m_neighbor_offset[4];               // Flat grid offsets of the four neighbours
+    std::vector<Scratch> m_scratch;         // One per thread
+    std::vector<long long> m_order;         // Queries sorted by start: start index in the high 32 bits, query in the low 32 bits
+    std::vector<int> m_group_begin;         // Position in m_order of the first query of each distinct start, plus the end
+    std::vector<int> m_path_thread;         // Per query: thread whose scratch holds the path
+    std::vector<std::size_t> m_path_offset; // Per query: position of the path in that thread's paths
+    int m_search_count = 0;
+    long long m_nodes_explored = 0;
+
+    /**
+     * @brief Run the search for one group of queries sharing a start and write their answers
+     * @param begin Position in m_order of the first query of the group
+     * @param end Position in m_order past the last query of the group
+     * @param queries The batch
+     * @param results Answers of the batch, lengths already sized
+     * @param withPaths Also write the paths to the scratch buffer of the thread
+     * @param thread OpenMP thread number of the caller, selecting its scratch buffers
+     */
+    void searchGroup(int begin, int end, const std::vector<PathQuery> &queries, PathQueryResults &results, bool withPaths,
+                     int thread);
+    /**
+     * @brief Get the flat grid index of a cell, -1 if it is out of bounds or a wall
+     */
+    int openIndex(Position position) const;
+};
+
+#endif // HOMEWORK_1_PATHQUERYENGINE_H_
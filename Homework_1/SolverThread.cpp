@@ -0,0 +1,209 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file SolverThread.cpp
+ * @brief Implementation of the background solver thread and its snapshot triple buffer
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "SolverThread.h"
+#include <algorithm>
+
+#define STEP_BATCH 256        // Full-speed steps between two clock reads
+#define PUBLISH_INTERVAL_MS 4 // Least time between two snapshots, a few per frame at 60 FPS
+#define MAX_SLEEP_MS 10       // Longest sleep of a throttled solve, so stop() and speed changes are seen quickly
+
+SolverThread::SolverThread() : m_stop(false), m_step_nanoseconds(0), m_middle(1), m_back(0), m_front(2)
+{
+}
+
+SolverThread::~SolverThread()
+{
+    stop();
+}
+
+void SolverThread::start(const Maze &maze, const SolverFactory &createSolver, int stepsPerSecond)
+{
+    stop();
+
+    // The solver refers to the maze copy, so it goes first
+    m_solver.reset();
+    m_maze = std::make_unique<Maze>(maze);
+    m_maze->takeChangedBlocks(m_new_blocks);
+    m_solver = createSolver(*m_maze);
+
+    // Every snapshot starts as the maze, so a snapshot only needs the blocks changed since the solve started
+    const std::size_t blockCount = (static_cast<std::size_t>(m_maze->getCellCount()) >> Maze::DIRTY_BLOCK_SHIFT) + 1;
+    for (int slot = 0; slot < 3; ++slot)
+    {
+        m_stale[slot].assign(blockCount, 0);
+        m_stale_blocks[slot].clear();
+    }
+    m_unseen.assign(blockCount, 0);
+    m_unseen_blocks.clear();
+    for (Snapshot &snapshot : m_snapshots)
+    {
+        snapshot.cells.assign(m_maze->getCells(), m_maze->getCells() + m_maze->getCellCount());
+        snapshot.changedBlocks.clear();
+        snapshot.nodesExplored = 0;
+        snapshot.steps = 0;
+        snapshot.solveTime = sf::Time::Zero;
+        snapshot.done = false;
+        snapshot.path.clear();
+    }
+    m_back = 0;
+    m_front = 2;
+    m_middle.store(1, std::memory_order_relaxed);
+    m_stop.store(false, std::memory_order_relaxed);
+    setStepsPerSecond(stepsPerSecond);
+
+    // Starting the thread publishes everything written above to it
+    m_thread = std::thread(&SolverThread::run, this);
+}
+
+void SolverThread::stop()
+{
+    if (m_thread.joinable())
+    {
+        m_stop.store(true, std::memory_order_relaxed);
+        m_thread.join();
+    }
+}
+
+void SolverThread::setStepsPerSecond(int stepsPerSecond)
+{
+    m_step_nanoseconds.store(stepsPerSecond > 0 ? 1000000000LL / stepsPerSecond : 0, std::memory_order_relaxed);
+}
+
+const SolverThread::Snapshot *SolverThread::acquireSnapshot()
+{
+    // Only the solver thread sets FRESH, so a stale read here just defers the snapshot to the next call
+    if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+    {
+        return nullptr;
+    }
+    m_front = m_middle.exchange(static_cast<std::uint8_t>(m_front), std::memory_order_acq_rel) & ~FRESH;
+    return &m_snapshots[m_front];
+}
+
+void SolverThread::run()
+{
+    int nodesExplored = 0;
+    long long steps = 0;
+    bool found = false;
+    sf::Time solveTime;
+    sf::Time nextStep;
+    sf::Clock wallClock;
+    sf::Clock publishClock;
+
+    // One step of the solver, true once the search has ended either way
+    auto step = [&]() {
+        ++steps;
+        found = m_solver->step(nodesExplored);
+        return found || m_solver->isExhausted();
+    };
+
+    bool done = false;
+    while (!done && !m_stop.load(std::memory_order_relaxed))
+    {
+        const sf::Time interval = sf::microseconds(m_step_nanoseconds.load(std::memory_order_relaxed) / 1000);
+        if (interval > sf::Time::Zero)
+        {
+            // Throttled: wait for the step's turn, then time the step alone
+            const sf::Time now = wallClock.getElapsedTime();
+            if (now < nextStep)
+            {
+                sf::sleep(std::min(nextStep - now, sf::milliseconds(MAX_SLEEP_MS)));
+                continue;
+            }
+            nextStep = std::max(nextStep + interval, now);
+            sf::Clock stepClock;
+            done = step();
+            solveTime += stepClock.getElapsedTime();
+        }
+        else
+        {
+            // Full speed: time a batch of steps, reading the clock per step would cost as much as a step
+            sf::Clock batchClock;
+            for (int i = 0; i < STEP_BATCH && !done; ++i)
+            {
+                done = step();
+            }
+            solveTime += batchClock.getElapsedTime();
+        }
+
+        if (!done && publishClock.getElapsedTime() >= sf::milliseconds(PUBLISH_INTERVAL_MS))
+        {
+            publish(nodesExplored, steps, solveTime, nullptr);
+            publishClock.restart();
+        }
+    }
+
+    // The solution cells are marked outside the timed steps, as the render thread does after its last step
+    if (done)
+    {
+        const std::vector<Position> noPath;
+        publish(nodesExplored, steps, solveTime, found ? &m_solver->reconstructPath() : &noPath);
+    }
+}
+
+void SolverThread::publish(int nodesExplored, long long steps, sf::Time solveTime, const std::vector<Position> *path)
+{
+    m_maze->takeChangedBlocks(m_new_blocks);
+    for (int slot = 0; slot < 3; ++slot)
+    {
+        for (int block : m_new_blocks)
+        {
+            if (!m_stale[slot][block])
+            {
+                m_stale[slot][block] = 1;
+                m_stale_blocks[slot].push_back(block);
+            }
+        }
+    }
+
+    // A middle snapshot without FRESH was acquired, so the renderer is at least as new as the last publish. Otherwise it may
+    // be older, and the blocks it has not seen keep adding up.
+    if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+    {
+        for (int block : m_unseen_blocks)
+        {
+            m_unseen[block] = 0;
+        }
+        m_unseen_blocks.clear();
+    }
+    for (int block : m_new_blocks)
+    {
+        if (!m_unseen[block])
+        {
+            m_unseen[block] = 1;
+            m_unseen_blocks.push_back(block);
+        }
+    }
+
+    // The back snapshot holds an older state of the same solve, so the blocks changed since it was filled bring it up to date
+    Snapshot &snapshot = m_snapshots[m_back];
+    const int cellCount = m_maze->getCellCount();
+    for (int block : m_stale_blocks[m_back])
+    {
+        const int first = block << Maze::DIRTY_BLOCK_SHIFT;
+        const int last = std::min(first + (1 << Maze::DIRTY_BLOCK_SHIFT), cellCount);
+        std::copy(m_maze->getCells() + first, m_maze->getCells() + last, snapshot.cells.begin() + first);
+        m_stale[m_back][block] = 0;
+    }
+    m_stale_blocks[m_back].clear();
+    snapshot.changedBlocks = m_unseen_blocks;
+    snapshot.nodesExplored = nodesExplored;
+    snapshot.steps = steps;
+    snapshot.solveTime = solveTime;
+    snapshot.done = path != nullptr;
+    if (path)
+    {
+        snapshot.path = *path;
+    }
+
+    m_back = m_middle.exchange(static_cast<std::uint8_t>(m_back | FRESH), std::memory_order_acq_rel) & ~FRESH;
+}
@@ -0,0 +1,145 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-02-13
+ * Description:  Homework 1: Maze Generator and Solver Visualization
+ *
+ * @file SolverThread.h
+ * @brief Runs a step-by-step solver on a background thread and hands its progress to the renderer
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * The animated solvers mark the cells they visit in the maze they search. On a background
+ * thread that maze is a private copy, so the window can keep drawing its own maze while the
+ * solver runs at full speed or at a given number of steps per second.
+ *
+ * Progress crosses threads in a lock-free triple buffer of snapshots. The solver thread fills
+ * the back snapshot and swaps it with the middle one in a single atomic exchange; the render
+ * thread swaps the middle snapshot with its front one when the middle is newer. Neither side
+ * ever waits for the other: the solver overwrites snapshots the renderer did not pick up yet,
+ * and the renderer keeps the last one it got until a newer one is published.
+ *
+ * Only the 64-cell blocks the solver changed are copied: each snapshot remembers the blocks
+ * changed since it was last filled, and hands the renderer the blocks changed since the last
+ * snapshot the renderer is known to have acquired, so a publish and a frame cost as much as
+ * the search changed, not as much as the grid.
+ */
+
+#ifndef HOMEWORK_1_SOLVERTHREAD_H_
+#define HOMEWORK_1_SOLVERTHREAD_H_
+
+#include "MazeGenerator.h"
+#include "MazeSolver.h"
+#include <SFML/System.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @class SolverThread
+ * @brief Background solver thread publishing snapshots of its maze through a triple buffer
+ *
+ * start() copies the maze and solves the copy on a new thread, stop() joins it. Only one
+ * thread calls the public functions; the snapshots it acquires stay valid until the next
+ * acquireSnapshot(), start() or stop().
+ */
+class SolverThread
+{
+  public:
+    /**
+     * @struct Snapshot
+     * @brief Progress of the solve at the moment it was published
+     */
+    struct Snapshot
+    {
+        std::vector<CellType> cells;    // Flat grid of the solver's maze, up to date in the blocks changed since the solve started
+        std::vector<int> changedBlocks; // Blocks of cells (see Maze::takeChangedBlocks) that may differ from the previous snapshot
+        int nodesExplored;              // Nodes explored so far
+        long long steps;                // Calls to MazeSolver::step() so far
+        sf::Time solveTime;             // Time spent in the solver, without the pauses of a throttled solve
+        bool done;                      // The search ended: path is the solution, or empty if the end cannot be reached
+        std::vector<Position> path;     // Positions from end back to start once done
+    };
+
+    /**
+     * @brief Creates the solver of a solve for the thread's copy of the maze
+     */
+    using SolverFactory = std::function<std::unique_ptr<MazeSolver>(Maze &)>;
+
+    SolverThread();
+    ~SolverThread();
+    SolverThread(const SolverThread &) = delete;
+    SolverThread &operator=(const SolverThread &) = delete;
+
+    /**
+     * @brief Stop the running solve, if any, and start solving a copy of a maze
+     * @param maze The maze to solve, copied before the thread starts
+     * @param createSolver Creates the solver for the copy
+     * @param stepsPerSecond Steps per second to throttle the solver to, 0 to run at full speed
+     */
+    void start(const Maze &maze, const SolverFactory &createSolver, int stepsPerSecond);
+
+    /**
+     * @brief Stop the running solve and join its thread; does nothing if no solve was started
+     */
+    void stop();
+
+    /**
+     * @brief Check if a solve was started and not stopped (it may have finished already)
+     */
+    bool isRunning() const
+    {
+        return m_thread.joinable();
+    }
+
+    /**
+     * @brief Change the throttle of the running solve, or of the next one
+     * @param stepsPerSecond Steps per second, 0 to run at full speed
+     */
+    void setStepsPerSecond(int stepsPerSecond);
+
+    /**
+     * @brief Take the latest snapshot if one was published since the last call
+     * @return The snapshot, or nullptr if there is nothing new
+     */
+    const Snapshot *acquireSnapshot();
+
+  private:
+    // m_middle holds the index of the middle snapshot, with FRESH set while it was not acquired yet
+    static constexpr std::uint8_t FRESH = 4;
+
+    std::unique_ptr<Maze> m_maze;              // Copy of the maze the solver marks
+    std::unique_ptr<MazeSolver> m_solver;
+    std::thread m_thread;
+    std::atomic<bool> m_stop;                  // Set by stop() for the thread to return
+    std::atomic<long long> m_step_nanoseconds; // Time between steps, 0 for full speed
+    Snapshot m_snapshots[3];
+    std::atomic<std::uint8_t> m_middle;        // Shared between both threads
+    int m_back;                                // Written by the solver thread only
+    int m_front;                               // Read by the render thread only
+
+    // Change tracking of the solver thread, by block of cells
+    std::vector<int> m_new_blocks;             // Blocks changed since the last publish
+    std::vector<std::uint8_t> m_stale[3];      // Per snapshot and block: changed since the snapshot was last filled
+    std::vector<int> m_stale_blocks[3];        // Blocks set in m_stale, per snapshot
+    std::vector<std::uint8_t> m_unseen;        // Per block: changed since the last snapshot known to be acquired
+    std::vector<int> m_unseen_blocks;          // Blocks set in m_unseen
+
+    /**
+     * @brief Body of the solver thread: step until the search ends or stop() is called
+     */
+    void run();
+
+    /**
+     * @brief Fill the back snapshot and swap it into the middle
+     * @param nodesExplored Nodes explored so far
+     * @param steps Steps taken so far
+     * @param solveTime Time spent in the solver so far
+     * @param path The path once the search ended (empty if the end cannot be reached), nullptr while it runs
+     */
+    void publish(int nodesExplored, long long steps, sf::Time solveTime, const std::vector<Position> *path);
+};
+
+#endif // HOMEWORK_1_SOLVERTHREAD_H_
@@ -6,7 +6,8 @@
  *
  *
  * @file Geometry.cpp
- * @brief Geometry calculations for ray tracing visualization. Determines ray intersections with line segments, rectangles, and circles.
+ * @brief Geometry calculations for ray tracing visualization. Determines ray intersections with line segments, rectangles, convex polygons
+ * and circles.
  */
 
 #include "Geometry.h"
@@ -19,8 +20,6 @@
 #include <utility>
 #include <vector>
 
-constexpr float PARALLEL_THRESHOLD = std::numeric_limits<float>::epsilon() * 100.0F;
-
 auto Geometry::intersectLineSegment(const Ray &ray, const sf::Vector2f &point1, const sf::Vector2f &point2) -> HitResult
 {
     HitResult result;
@@ -63,103 +62,123 @@ auto Geometry::intersectLineSegment(const Ray &ray, const sf::Vector2f &point1,
 
 auto Geometry::intersectRectangle(const Ray &ray, const sf::RectangleShape &rectangle) -> HitResult
 {
-    HitResult closest_result;
-    closest_result.hit = false;
-    closest_result.distance = std::numeric_limits<float>::max();
+    auto rotation_radians = rectangle.getRotation() * static_cast<float>(M_PI) / 180.0F;
+    return intersectRectangle(ray, rectangle, std::cos(rotation_radians), std::sin(rotation_radians));
+}
 
+auto Geometry::intersectRectangle(const Ray &ray, const sf::RectangleShape &rectangle, float cos_rotation, float sin_rotation) -> HitResult
+{
     // Get rectangle properties
     sf::Vector2f pos = rectangle.getPosition();
     sf::Vector2f size = rectangle.getSize();
-    float rotation_degrees = rectangle.getRotation();
-    auto rotation_radians = rotation_degrees * static_cast<float>(M_PI) / 180.0F;
 
     // Calculate the four corners of the rectangle
     // Corners relative to position (0,0)
-    std::array<sf::Vector2f, 4> corners = {{
+    const std::array<sf::Vector2f, 4> corners = {{
         {0.0F, 0.0F},     // Top-left
         {size.x, 0.0F},   // Top-right
         {size.x, size.y}, // Bottom-right
         {0.0F, size.y}    // Bottom-left
     }};
 
-    // Rotate and translate corners to world space
-    auto cos_rotate = std::cos(rotation_radians);
-    auto sin_rotate = std::sin(rotation_radians);
-
+    // Rotate and translate corners to world space (using cached cos/sin)
     std::array<sf::Vector2f, 4> rotated_corners;
     for (size_t i = 0; i < corners.size(); ++i)
     {
         const auto &corner = corners.at(i);
         // Rotate the corner around the origin
-        float rotated_x = (corner.x * cos_rotate) - (corner.y * sin_rotate);
-        float rotated_y = (corner.x * sin_rotate) + (corner.y * cos_rotate);
+        float rotated_x = (corner.x * cos_rotation) - (corner.y * sin_rotation);
+        float rotated_y = (corner.x * sin_rotation) + (corner.y * cos_rotation);
 
         // Translate to the rectangle's position
         rotated_corners.at(i) = {rotated_x + pos.x, rotated_y + pos.y};
     }
 
-    // Test ray intersection against each edge of the rotated rectangle
+    // Clip the ray against the 4 edge half-planes in one pass instead of 4 separate segment tests.
+    // A rotation keeps the corner winding, so the outward normal of edge a->b is always (b - a) rotated by -90 degrees.
+    std::array<float, 4> normal_x{};
+    std::array<float, 4> normal_y{};
+    std::array<float, 4> offset{};
     for (size_t i = 0; i < 4; ++i)
     {
-        size_t next = (i + 1) % 4;
-        HitResult edge_hit = intersectLineSegment(ray, rotated_corners.at(i), rotated_corners.at(next));
-
-        // Keep track of the closest valid hit
-        if (edge_hit.hit && edge_hit.distance < closest_result.distance)
-        {
-            closest_result = edge_hit;
-        }
+        const auto &from = rotated_corners.at(i);
+        const auto &to = rotated_corners.at((i + 1) % 4);
+        normal_x.at(i) = to.y - from.y;
+        normal_y.at(i) = from.x - to.x;
+        offset.at(i) = (normal_x.at(i) * from.x) + (normal_y.at(i) * from.y);
     }
 
-    return closest_result;
+    return intersectConvexPolygon(ray, EdgePlaneView{normal_x.data(), normal_y.data(), offset.data(), 4});
 }
 
-auto Geometry::intersectRectangle(const Ray &ray, const sf::RectangleShape &rectangle, float cos_rotation, float sin_rotation) -> HitResult
+auto Geometry::intersectConvexPolygon(const Ray &ray, const EdgePlaneView &edges) -> HitResult
 {
-    HitResult closest_result;
-    closest_result.hit = false;
-    closest_result.distance = std::numeric_limits<float>::max();
+    HitResult result;
 
-    // Get rectangle properties
-    sf::Vector2f pos = rectangle.getPosition();
-    sf::Vector2f size = rectangle.getSize();
+    float t = clipConvexPolygon(ray, edges);
+    if (t < 0.0F)
+    {
+        return result;
+    }
 
-    // Calculate the four corners of the rectangle
-    // Corners relative to position (0,0)
-    const std::array<sf::Vector2f, 4> corners = {{
-        {0.0F, 0.0F},     // Top-left
-        {size.x, 0.0F},   // Top-right
-        {size.x, size.y}, // Bottom-right
-        {0.0F, size.y}    // Bottom-left
-    }};
+    result.hit = true;
+    result.distance = t;
+    result.point = ray.origin + (ray.direction * t);
 
-    // Rotate and translate corners to world space (using cached cos/sin)
-    std::array<sf::Vector2f, 4> rotated_corners;
-    for (size_t i = 0; i < corners.size(); ++i)
+    return result;
+}
+
+auto Geometry::intersectConvexPolygon(const Ray &ray, const sf::ConvexShape &polygon) -> HitResult
+{
+    std::vector<sf::Vector2f> vertices(polygon.getPointCount());
+    const sf::Transform &transform = polygon.getTransform();
+    for (std::size_t i = 0; i < vertices.size(); ++i)
     {
-        const auto &corner = corners.at(i);
-        // Rotate the corner around the origin
-        float rotated_x = (corner.x * cos_rotation) - (corner.y * sin_rotation);
-        float rotated_y = (corner.x * sin_rotation) + (corner.y * cos_rotation);
+        vertices.at(i) = transform.transformPoint(polygon.getPoint(i));
+    }
 
-        // Translate to the rectangle's position
-        rotated_corners.at(i) = {rotated_x + pos.x, rotated_y + pos.y};
+    std::vector<float> normal_x;
+    std::vector<float> normal_y;
+    std::vector<float> offset;
+    appendEdgePlanes(vertices, normal_x, normal_y, offset);
+
+    return intersectConvexPolygon(ray, EdgePlaneView{normal_x.data(), normal_y.data(), offset.data(), normal_x.size()});
+}
+
+auto Geometry::appendEdgePlanes(const std::vector<sf::Vector2f> &vertices, std::vector<float> &normalX, std::vector<float> &normalY,
+                                std::vector<float> &offset) -> void
+{
+    // Twice the signed area tells us the winding; a positive area means (b - a) rotated by -90 degrees points outward
+    float signed_area = 0.0F;
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        const auto &from = vertices.at(i);
+        const auto &to = vertices.at((i + 1) % vertices.size());
+        signed_area += (from.x * to.y) - (to.x * from.y);
     }
+    const float winding = (signed_area >= 0.0F) ? 1.0F : -1.0F;
 
-    // Test ray intersection against each edge of the rotated rectangle
-    for (size_t i = 0; i < 4; ++i)
+    for (std::size_t i = 0; i < vertices.size(); ++i)
     {
-        size_t next = (i + 1) % 4;
-        HitResult edge_hit = intersectLineSegment(ray, rotated_corners.at(i), rotated_corners.at(next));
-
-        // Keep track of the closest valid hit
-        if (edge_hit.hit && edge_hit.distance < closest_result.distance)
-        {
-            closest_result = edge_hit;
-        }
+        const auto &from = vertices.at(i);
+        const auto &to = vertices.at((i + 1) % vertices.size());
+        float normal_x = winding * (to.y - from.y);
+        float normal_y = winding * (from.x - to.x);
+        normalX.push_back(normal_x);
+        normalY.push_back(normal_y);
+        offset.push_back((normal_x * from.x) + (normal_y * from.y));
     }
+}
 
-    return closest_result;
+auto Geometry::rectangleCorners(const sf::RectangleShape &rectangle) -> std::vector<sf::Vector2f>
+{
+    std::vector<sf::Vector2f> corners(rectangle.getPointCount());
+    const sf::Transform &transform = rectangle.getTransform();
+    for (std::size_t i = 0; i < corners.size(); ++i)
+    {
+        corners.at(i) = transform.transformPoint(rectangle.getPoint(i));
+    }
+    return corners;
 }
 
 auto Geometry::intersectCircle(const Ray &ray, const sf::CircleShape &circle) -> HitResult
@@ -171,40 +190,7 @@ auto Geometry::intersectCircle(const Ray &ray, const sf::CircleShape &circle) ->
     float radius = circle.getRadius();
     sf::Vector2f center = circle.getPosition() + sf::Vector2f(radius, radius);
 
-    // Vector from ray origin to circle center
-    sf::Vector2f oc = ray.origin - center;
-
-    // Quadratic formula: t²(d·d) + 2t(oc·d) + (oc·oc - r²) = 0
-    // Since direction is normalized: d·d = 1
-    float a = 1.0F; // ray.direction · ray.direction
-    float b = 2.0F * ((oc.x * ray.direction.x) + (oc.y * ray.direction.y));
-    float c = ((oc.x * oc.x) + (oc.y * oc.y)) - (radius * radius);
-
-    // Discriminant
-    float discriminant = (b * b) - (4.0F * a * c);
-
-    // discriminant < 0 there is no intersection.
-    if (discriminant < 0.0F)
-    {
-        return result;
-    }
-
-    // discriminant ≥ 0, then t = (−b ± √discriminant) / 2a
-    auto sqrt_discriminant = std::sqrt(discriminant);
-    float t1 = (-b - sqrt_discriminant) / (2.0F * a);
-    float t2 = (-b + sqrt_discriminant) / (2.0F * a);
-
-    // take the smallest positive t
-    // We want the closest intersection in front of the ray (t > 0)
-    float t = -1.0F;
-    if (t1 > 0.0F)
-    {
-        t = t1;
-    }
-    else if (t2 > 0.0F)
-    {
-        t = t2;
-    }
+    float t = clipCircle(ray, center, radius * radius);
 
     // No valid intersection
     if (t < 0.0F)
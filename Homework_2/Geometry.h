@@ -6,15 +6,19 @@
  *
  *
  * @file Geometry.h
- * @brief Geometry calculations header file for ray tracing visualization. Determines ray intersections with line segments, rectangles, and
- * circles.
+ * @brief Geometry calculations header file for ray tracing visualization. Determines ray intersections with line segments, rectangles,
+ * convex polygons and circles.
  */
 
 #ifndef HOMEWORK_2_GEOMETRY_H_
 #define HOMEWORK_2_GEOMETRY_H_
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <limits>
+#include <vector>
 
 // @brief Struct to represent a ray in 2D space
 struct Ray
@@ -23,6 +27,19 @@ struct Ray
     sf::Vector2f direction; // unit vector
 };
 
+/**
+ * @brief Read-only view of the edge half-planes of one convex polygon in structure-of-arrays layout
+ * Edge i is the half-plane normal_i · x <= offset_i with the normal pointing out of the polygon, so the polygon is the
+ * intersection of all edge half-planes.
+ */
+struct EdgePlaneView
+{
+    const float *normalX = nullptr;
+    const float *normalY = nullptr;
+    const float *offset = nullptr;
+    std::size_t count = 0;
+};
+
 // @brief Struct to represent the result of a ray intersection test
 struct HitResult
 {
@@ -34,12 +51,83 @@ struct HitResult
 
 /**
  * @brief Geometry class containing static methods for ray-shape intersection tests
- * This class provides methods to test intersection between rays and various shapes (line segments, rectangles, circles).
+ * This class provides methods to test intersection between rays and various shapes (line segments, rectangles, convex polygons, circles).
  */
 class Geometry
 {
   private:
+    static constexpr float PARALLEL_THRESHOLD = std::numeric_limits<float>::epsilon() * 100.0F;
+
   public:
+    /**
+     * @brief Distance along a ray to a circle, the inlined kernel behind intersectCircle
+     * @param ray The ray to test
+     * @param center Center of the circle
+     * @param radiusSquared Squared radius of the circle
+     * @return Distance to the closest intersection in front of the ray, or a negative value if there is none
+     */
+    static auto clipCircle(const Ray &ray, const sf::Vector2f &center, float radiusSquared) -> float
+    {
+        // Vector from ray origin to circle center
+        sf::Vector2f oc = ray.origin - center;
+
+        // Quadratic formula: t²(d·d) + 2t(oc·d) + (oc·oc - r²) = 0
+        // Since direction is normalized: d·d = 1
+        float b = 2.0F * ((oc.x * ray.direction.x) + (oc.y * ray.direction.y));
+        float c = ((oc.x * oc.x) + (oc.y * oc.y)) - radiusSquared;
+
+        // discriminant < 0 there is no intersection.
+        float discriminant = (b * b) - (4.0F * c);
+        if (discriminant < 0.0F)
+        {
+            return -1.0F;
+        }
+
+        // discriminant ≥ 0, then t = (−b ± √discriminant) / 2
+        // take the smallest positive t (closest intersection in front of the ray)
+        auto sqrt_discriminant = std::sqrt(discriminant);
+        float t1 = (-b - sqrt_discriminant) * 0.5F;
+        float t2 = (-b + sqrt_discriminant) * 0.5F;
+        return (t1 > 0.0F) ? t1 : ((t2 > 0.0F) ? t2 : -1.0F);
+    }
+
+    /**
+     * @brief Distance along a ray to a convex polygon, the inlined kernel behind intersectConvexPolygon
+     * All edges are clipped against the ray in a single branch-free pass (Cyrus-Beck), so the loop vectorizes.
+     * @param ray The ray to test
+     * @param edges Edge half-planes of the polygon (see appendEdgePlanes)
+     * @return Distance to the entry point, the exit point if the ray starts inside, or a negative value if there is no hit
+     */
+    static auto clipConvexPolygon(const Ray &ray, const EdgePlaneView &edges) -> float
+    {
+        // Ray: R(t) = ray.origin + t * ray.direction.  R(t) is inside edge i when n·R(t) <= offset, i.e. t * (n·d) <= offset - n·o
+        // Edges facing the ray (n·d < 0) bound where the ray enters, edges facing away (n·d > 0) bound where it exits.
+        float t_enter = -std::numeric_limits<float>::max();
+        float t_exit = std::numeric_limits<float>::max();
+        int outside = 0; // Set when the ray runs parallel to an edge on its outer side
+
+#pragma omp simd reduction(max : t_enter) reduction(min : t_exit) reduction(| : outside)
+        for (std::size_t i = 0; i < edges.count; ++i)
+        {
+            float denominator = (edges.normalX[i] * ray.direction.x) + (edges.normalY[i] * ray.direction.y);
+            float numerator = edges.offset[i] - ((edges.normalX[i] * ray.origin.x) + (edges.normalY[i] * ray.origin.y));
+
+            bool parallel = std::abs(denominator) < PARALLEL_THRESHOLD;
+            float t = numerator / (parallel ? 1.0F : denominator);
+
+            outside |= static_cast<int>(parallel && numerator < 0.0F);
+            t_enter = std::max(t_enter, (!parallel && denominator < 0.0F) ? t : -std::numeric_limits<float>::max());
+            t_exit = std::min(t_exit, (!parallel && denominator > 0.0F) ? t : std::numeric_limits<float>::max());
+        }
+
+        // Missed the polygon entirely, or the whole overlap is behind the ray
+        if (outside != 0 || t_enter > t_exit || t_exit < 0.0F)
+        {
+            return -1.0F;
+        }
+        return (t_enter >= 0.0F) ? t_enter : t_exit;
+    }
+
     /**
      * @brief Test intersection between a ray and a line segment defined by two points
      * @param ray The ray to test
@@ -68,6 +156,41 @@ class Geometry
     static auto intersectRectangle(const Ray &ray, const sf::RectangleShape &rectangle, float cos_rotation, float sin_rotation)
         -> HitResult;
 
+    /**
+     * @brief Test intersection between a ray and a convex polygon given by its edge half-planes
+     * A ray starting inside the polygon reports the exit point, matching the per-edge segment tests.
+     * @param ray The ray to test
+     * @param edges Edge half-planes of the polygon (see appendEdgePlanes)
+     * @return HitResult containing intersection information
+     */
+    static auto intersectConvexPolygon(const Ray &ray, const EdgePlaneView &edges) -> HitResult;
+
+    /**
+     * @brief Test intersection between a ray and an SFML convex shape, transformed into world space
+     * @param ray The ray to test
+     * @param polygon The convex shape to test against
+     * @return HitResult containing intersection information
+     */
+    static auto intersectConvexPolygon(const Ray &ray, const sf::ConvexShape &polygon) -> HitResult;
+
+    /**
+     * @brief Append the outward edge half-planes of a convex polygon to structure-of-arrays buffers
+     * Vertices may be in either winding order; the normals are flipped as needed so they point out of the polygon.
+     * @param vertices World-space vertices of the convex polygon in order around its boundary
+     * @param normalX Buffer receiving the x component of each edge normal
+     * @param normalY Buffer receiving the y component of each edge normal
+     * @param offset Buffer receiving normal · edge start for each edge
+     */
+    static auto appendEdgePlanes(const std::vector<sf::Vector2f> &vertices, std::vector<float> &normalX, std::vector<float> &normalY,
+                                 std::vector<float> &offset) -> void;
+
+    /**
+     * @brief Get the world-space vertices of a (possibly rotated) rectangle
+     * @param rectangle The rectangle shape
+     * @return The four corners in boundary order
+     */
+    static auto rectangleCorners(const sf::RectangleShape &rectangle) -> std::vector<sf::Vector2f>;
+
     /**
      * @brief Test intersection between a ray and a circle (sphere in 2D)
      * @param ray The ray to test
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <numeric>
 #include <optional>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
@@ -40,7 +41,9 @@ enum class RenderMode : std::uint8_t
 {
     SingleThreaded,
     OpenMP,
-    StdThread
+    StdThread,
+    ParallelSTL,
+    OpenMPSimd
 };
 
 // @brief Convert RenderMode enum to string representation
@@ -54,6 +57,10 @@ auto renderModeToString(RenderMode mode) -> std::string
         return "OpenMP";
     case RenderMode::StdThread:
         return "StdThread";
+    case RenderMode::ParallelSTL:
+        return "ParallelSTL";
+    case RenderMode::OpenMPSimd:
+        return "OpenMP-SIMD";
     default:
         return "Unknown";
     }
@@ -74,6 +81,14 @@ auto renderModeFromString(const std::string &mode) -> RenderMode
     {
         return RenderMode::StdThread;
     }
+    if (mode == "ParallelSTL")
+    {
+        return RenderMode::ParallelSTL;
+    }
+    if (mode == "OpenMP-SIMD")
+    {
+        return RenderMode::OpenMPSimd;
+    }
 
     return RenderMode::SingleThreaded; // Default case
 }
@@ -188,18 +203,43 @@ auto getRays(int numRays, const sf::Vector2f &mousePos, const std::vector<HitRes
     return rays;
 }
 
+/** @brief Create vertex array for rays already traced and shaded by the OpenMP-SIMD kernel
+ *  @param numRays The number of rays
+ *  @param mousePos The position of the light source (mouse cursor)
+ *  @param shaded End points and RGBA colors (alpha already set from distance) for each ray
+ *  @return An sf::VertexArray containing line vertices for rendering rays
+ */
+auto getRays(int numRays, const sf::Vector2f &mousePos, const ShadedRays &shaded) -> sf::VertexArray
+{
+    sf::VertexArray rays(sf::Lines, static_cast<std::size_t>(2 * numRays)); // Need 2 vertices per line
+    for (std::size_t i = 0; i < static_cast<std::size_t>(numRays); ++i)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+        rays[2 * i].position = mousePos;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+        rays[2 * i].color = sf::Color(255, 100, 0, 30);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+        rays[(2 * i) + 1].position = sf::Vector2f(shaded.hitX.at(i), shaded.hitY.at(i));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+        rays[(2 * i) + 1].color = sf::Color(shaded.color.at(i));
+    }
+
+    return rays;
+}
+
 /** @brief Execute ray tracing based on the current rendering mode
- *  @param mode The current rendering mode (SingleThreaded, OpenMP, StdThread)
+ *  @param mode The current rendering mode (SingleThreaded, OpenMP, StdThread, ParallelSTL, OpenMPSimd)
  *  @param rayTracer Reference to the RayTracer instance
  *  @param scene Reference to the Scene
  *  @param mousePos Position of the light source
  *  @param numRays Number of rays to cast
  *  @param currentThreadCount Number of threads to use for parallel modes
  *  @param results Vector to store ray intersection results
+ *  @param shaded Ray end points and colors, filled instead of results in OpenMPSimd mode
  *  @return Elapsed time in microseconds for the ray tracing operation
  */
 auto executeRayTracing(RenderMode mode, const Scene &scene, const sf::Vector2f &mousePos, int numRays, int currentThreadCount,
-                       std::vector<HitResult> &results) -> int32_t
+                       std::vector<HitResult> &results, ShadedRays &shaded) -> int32_t
 {
     auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -214,6 +254,12 @@ auto executeRayTracing(RenderMode mode, const Scene &scene, const sf::Vector2f &
     case RenderMode::StdThread:
         RayTracer::castRaysStdThread(mousePos, numRays, scene, results, currentThreadCount);
         break;
+    case RenderMode::ParallelSTL:
+        RayTracer::castRaysParallelSTL(mousePos, numRays, scene, results, currentThreadCount);
+        break;
+    case RenderMode::OpenMPSimd:
+        RayTracer::castRaysOpenMPSimd(mousePos, numRays, scene, shaded, currentThreadCount);
+        break;
     }
 
     auto stopTime = std::chrono::high_resolution_clock::now();
@@ -253,14 +299,64 @@ auto updateTimingAndGetAverage(std::deque<int32_t> &timings, int32_t elapsed, in
     return std::nullopt;
 }
 
+/** @brief Time line-of-sight queries between random agent pairs with and without coherence sorting, without opening a window
+ *  @param numQueries Number of agent pairs to query
+ *  @param numPolygons Number of convex polygons in the benchmark scene
+ *  @param numThreads Number of threads used to trace each batch
+ */
+void runBatchBenchmark(int numQueries, int numPolygons, int numThreads)
+{
+    const int SCENE_WIDTH = 1800;
+    const int SCENE_HEIGHT = 1000;
+    const int REPETITIONS = 10;
+    Scene scene(SCENE_WIDTH, SCENE_HEIGHT, 2, 4, numPolygons);
+
+    // Random agents; each query asks whether agent a can see agent b
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_real_distribution<float> xDist(0.0F, static_cast<float>(SCENE_WIDTH));
+    std::uniform_real_distribution<float> yDist(0.0F, static_cast<float>(SCENE_HEIGHT));
+    std::vector<sf::Vector2f> origins(static_cast<std::size_t>(numQueries));
+    std::vector<sf::Vector2f> directions(origins.size());
+    std::vector<float> maxDistances(origins.size());
+    for (std::size_t i = 0; i < origins.size(); ++i)
+    {
+        origins.at(i) = {xDist(rng), yDist(rng)};
+        sf::Vector2f target{xDist(rng), yDist(rng)};
+        sf::Vector2f delta = target - origins.at(i);
+        float length = std::max(std::hypot(delta.x, delta.y), 1.0F);
+        directions.at(i) = delta / length;
+        maxDistances.at(i) = length;
+    }
+
+    const RayBatch batch{origins.data(), directions.data(), maxDistances.data(), origins.size()};
+    std::vector<HitResult> hits(origins.size());
+    for (bool sorted : {false, true})
+    {
+        // One untimed warm-up pass, then average the repetitions
+        RayTracer::traceBatch(batch, scene, hits.data(), numThreads, sorted);
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (int repetition = 0; repetition < REPETITIONS; ++repetition)
+        {
+            RayTracer::traceBatch(batch, scene, hits.data(), numThreads, sorted);
+        }
+        auto stopTime = std::chrono::high_resolution_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(stopTime - startTime).count() / REPETITIONS;
+        auto blocked = std::count_if(hits.begin(), hits.end(), [](const HitResult &hit) -> bool { return hit.hit; });
+        std::cout << (sorted ? "Sorted" : "Unsorted") << " batch: " << numQueries << " queries, " << elapsed << " microseconds, " << blocked
+                  << " blocked\n";
+    }
+}
+
 /** @brief Display help message for command line arguments */
 void printHelp()
 {
     std::cout << "Ray Tracer - Usage:\n"
-              << "  -m, --mode <mode>           Rendering mode: Single-Threaded, OpenMP, or StdThread (default: Single-Threaded)\n"
+              << "  -m, --mode <mode>           Rendering mode: Single-Threaded, OpenMP, StdThread, ParallelSTL, or OpenMP-SIMD (default: Single-Threaded)\n"
               << "  -t, --num-threads <count>   Number of threads for parallel modes (default: 2)\n"
               << "  -r, --num-rays <count>      Number of rays (default: 3600)\n"
+              << "  -p, --num-polygons <count>  Number of random convex polygons in the scene (default: 0)\n"
               << "  -c, --csv <sampleCount>     Enable CSV output for performance metrics with optional sample count\n"
+              << "  -b, --batch-bench <count>   Benchmark <count> batched line-of-sight queries (sorted vs unsorted) and exit\n"
               << "  -h, --help                  Display this help message\n"
               << "\n"
               << "Example:\n"
@@ -276,10 +372,12 @@ void printHelp()
  * @param numRays Reference to store the number of rays
  * @param enableCSV Reference to store CSV flag
  * @param sampleCount Reference to store sample count for CSV reporting
+ * @param numPolygons Reference to store the number of convex polygons in the scene
+ * @param batchQueries Reference to store the number of batched queries to benchmark (0 runs the interactive window)
  */
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 void parseArgs(std::size_t argc, const std::vector<const char *> &argv, RenderMode &mode, int &numThreads, int &numRays, bool &enableCSV,
-               int &sampleCount)
+               int &sampleCount, int &numPolygons, int &batchQueries)
 {
     for (std::size_t i = 1; i < argc; ++i)
     {
@@ -373,6 +471,51 @@ void parseArgs(std::size_t argc, const std::vector<const char *> &argv, RenderMo
                 exit(EXIT_FAILURE);
             }
         }
+        else if (arg == "--num-polygons" || arg == "-p")
+        {
+            if (i + 1 < argc)
+            {
+                try
+                {
+                    numPolygons = std::max(0, std::stoi(argv.at(++i)));
+                    std::cout << "Number of polygons set to: " << numPolygons << "\n";
+                }
+                catch (const std::invalid_argument &e)
+                {
+                    std::cerr << "Error: --num-polygons requires a valid integer\n";
+                    printHelp();
+                    exit(EXIT_FAILURE);
+                }
+            }
+            else
+            {
+                std::cerr << "Error: --num-polygons requires a value\n";
+                printHelp();
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (arg == "--batch-bench" || arg == "-b")
+        {
+            if (i + 1 < argc)
+            {
+                try
+                {
+                    batchQueries = std::max(0, std::stoi(argv.at(++i)));
+                }
+                catch (const std::invalid_argument &e)
+                {
+                    std::cerr << "Error: --batch-bench requires a valid integer\n";
+                    printHelp();
+                    exit(EXIT_FAILURE);
+                }
+            }
+            else
+            {
+                std::cerr << "Error: --batch-bench requires a value\n";
+                printHelp();
+                exit(EXIT_FAILURE);
+            }
+        }
         else
         {
             std::cerr << "Error: Unknown argument '" << arg << "'\n";
@@ -394,6 +537,23 @@ auto main(int argc, const char *argv[]) -> int
         std::deque<int32_t> timings;
         const int MAX_ITERATIONS = 60;
 
+        RenderMode mode = RenderMode::SingleThreaded; // Default to single-threaded mode
+        int numRays = rayCountIncrement;              // Default to 3600 rays for 1 degree resolution
+        int currentThreadCount = 2;
+        bool enableCSV = false;
+        int sampleCount = 1000;
+        int numPolygons = 0;
+        int batchQueries = 0;
+        parseArgs(static_cast<std::size_t>(argc), std::vector<const char *>(argv, argv + argc), mode, currentThreadCount, numRays,
+                  enableCSV, sampleCount, numPolygons, batchQueries);
+
+        // Headless batch benchmark does not need a window
+        if (batchQueries > 0)
+        {
+            runBatchBenchmark(batchQueries, numPolygons, currentThreadCount);
+            return 0;
+        }
+
         // Window and pane dimensions
         sf::VideoMode desktopMode = sf::VideoMode::getDesktopMode();
         const unsigned int WINDOW_WIDTH = desktopMode.width > 0 ? desktopMode.width - 100 : 1000;   // Use desktop width or fallback to 1000
@@ -405,14 +565,6 @@ auto main(int argc, const char *argv[]) -> int
         sf::RenderWindow window(sf::VideoMode({WINDOW_WIDTH, WINDOW_HEIGHT}), "Ray Tracer");
         window.setFramerateLimit(60);
 
-        RenderMode mode = RenderMode::SingleThreaded; // Default to single-threaded mode
-        int numRays = rayCountIncrement;              // Default to 3600 rays for 1 degree resolution
-        int currentThreadCount = 2;
-        bool enableCSV = false;
-        int sampleCount = 1000;
-        parseArgs(static_cast<std::size_t>(argc), std::vector<const char *>(argv, argv + argc), mode, currentThreadCount, numRays,
-                  enableCSV, sampleCount);
-
         // Create Report object for CSV reporting if enabled
         std::cout << "Initializing report with CSV enabled: " << std::boolalpha << enableCSV << " and sample count: " << sampleCount
                   << "\n";
@@ -422,8 +574,9 @@ auto main(int argc, const char *argv[]) -> int
         sf::Font font = loadFont("fonts/KOMIKAP_.ttf", argv[0]);
 
         // Create scene with adjusted drawable area (excluding pane)
-        Scene scene(static_cast<int>(DRAWABLE_WIDTH), static_cast<int>(DRAWABLE_HEIGHT), 2, 4);
+        Scene scene(static_cast<int>(DRAWABLE_WIDTH), static_cast<int>(DRAWABLE_HEIGHT), 2, 4, numPolygons);
         std::vector<HitResult> results;
+        ShadedRays shaded; // Output of the fused OpenMP-SIMD trace-and-shade kernel
         sf::RectangleShape pane(sf::Vector2f(DRAWABLE_WIDTH, PANE_HEIGHT));
         pane.setPosition(0, DRAWABLE_HEIGHT);
         pane.setFillColor(sf::Color(50, 50, 50, 200)); // Dark semi-transparent
@@ -475,6 +628,14 @@ auto main(int argc, const char *argv[]) -> int
                         {
                             mode = RenderMode::StdThread;
                         }
+                        else if (mode == RenderMode::StdThread)
+                        {
+                            mode = RenderMode::ParallelSTL;
+                        }
+                        else if (mode == RenderMode::ParallelSTL)
+                        {
+                            mode = RenderMode::OpenMPSimd;
+                        }
                         else
                         {
                             mode = RenderMode::SingleThreaded;
@@ -505,7 +666,7 @@ auto main(int argc, const char *argv[]) -> int
             sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
 
             // Execute ray tracing and measure elapsed time
-            auto elapsedMicroseconds = executeRayTracing(mode, scene, mousePos, numRays, currentThreadCount, results);
+            auto elapsedMicroseconds = executeRayTracing(mode, scene, mousePos, numRays, currentThreadCount, results, shaded);
             sf::Text timingText;
             // Update timing history and get average if ready, and write CSV if enabled
             if (auto average = updateTimingAndGetAverage(timings, elapsedMicroseconds, MAX_ITERATIONS, report, renderModeToString(mode),
@@ -518,7 +679,8 @@ auto main(int argc, const char *argv[]) -> int
             }
 
             // Create vertex array for rays based on hit results
-            sf::VertexArray lines = getRays(numRays, mousePos, results);
+            sf::VertexArray lines =
+                (mode == RenderMode::OpenMPSimd) ? getRays(numRays, mousePos, shaded) : getRays(numRays, mousePos, results);
 
             // Clear window and draw scene
             window.clear(sf::Color::Black);
@@ -0,0 +1,200 @@
+/**
+ * Author: Jennifer Cwagenberg
+ * Class: ECE6122
+ * Last Date Modified: 2026-03-10
+ * Description:  Homework 2: Ray Tracing Visualization with Multiple Rendering Modes
+ *
+ *
+ * @file Primitives.h
+ * @brief Compile-time dispatched primitive storage for ray tracing. Each primitive kind keeps its data in structure-of-arrays form and
+ * owns its own inlined intersection loop; PrimitiveSet visits every registered kind with a fold expression, so the hot loop has no
+ * virtual dispatch or type switch.
+ */
+
+#ifndef HOMEWORK_2_PRIMITIVES_H_
+#define HOMEWORK_2_PRIMITIVES_H_
+
+#include "Geometry.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Circles stored as parallel arrays of center and squared radius
+ */
+struct CirclePrimitives
+{
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> radiusSquared;
+    std::vector<sf::Color> colors;
+    std::vector<std::uint32_t> packedColors; // colors as RGBA integers for vectorized kernels
+
+    /** @brief Remove all circles
+     */
+    auto clear() -> void
+    {
+        centerX.clear();
+        centerY.clear();
+        radiusSquared.clear();
+        colors.clear();
+        packedColors.clear();
+    }
+
+    /** @brief Add a circle from its SFML shape, hit color is the outline color
+     *  @param circle The circle shape to add
+     */
+    auto add(const sf::CircleShape &circle) -> void
+    {
+        // In SFML, CircleShape position is top-left, so center is position + radius
+        float radius = circle.getRadius();
+        centerX.push_back(circle.getPosition().x + radius);
+        centerY.push_back(circle.getPosition().y + radius);
+        radiusSquared.push_back(radius * radius);
+        colors.push_back(circle.getOutlineColor());
+        packedColors.push_back(circle.getOutlineColor().toInteger());
+    }
+
+    /** @brief Update closest with the nearest circle hit that is closer than the current one
+     *  @param ray The ray to test
+     *  @param closest The closest hit found so far (only distance, color and hit are updated)
+     */
+    auto closestHit(const Ray &ray, HitResult &closest) const -> void
+    {
+        for (std::size_t i = 0; i < radiusSquared.size(); ++i)
+        {
+            float t = Geometry::clipCircle(ray, {centerX[i], centerY[i]}, radiusSquared[i]);
+            if (t >= 0.0F && t < closest.distance)
+            {
+                closest.hit = true;
+                closest.distance = t;
+                closest.color = colors[i];
+            }
+        }
+    }
+};
+
+/**
+ * @brief Convex polygons (including rotated rectangles) stored as one flat array of edge half-planes
+ * Polygon i owns edges [edgeStart[i], edgeStart[i + 1]).
+ */
+struct ConvexPolygonPrimitives
+{
+    std::vector<float> normalX;
+    std::vector<float> normalY;
+    std::vector<float> offset;
+    std::vector<std::size_t> edgeStart{0};
+    std::vector<sf::Color> colors;
+    std::vector<std::uint32_t> packedColors; // colors as RGBA integers for vectorized kernels
+
+    /** @brief Remove all polygons
+     */
+    auto clear() -> void
+    {
+        normalX.clear();
+        normalY.clear();
+        offset.clear();
+        edgeStart.assign(1, 0);
+        colors.clear();
+        packedColors.clear();
+    }
+
+    /** @brief Add a convex polygon from its world-space vertices
+     *  @param vertices Polygon vertices in boundary order (either winding)
+     *  @param color Color reported when the polygon is hit
+     */
+    auto add(const std::vector<sf::Vector2f> &vertices, sf::Color color) -> void
+    {
+        Geometry::appendEdgePlanes(vertices, normalX, normalY, offset);
+        edgeStart.push_back(offset.size());
+        colors.push_back(color);
+        packedColors.push_back(color.toInteger());
+    }
+
+    /** @brief Update closest with the nearest polygon hit that is closer than the current one
+     *  @param ray The ray to test
+     *  @param closest The closest hit found so far (only distance, color and hit are updated)
+     */
+    auto closestHit(const Ray &ray, HitResult &closest) const -> void
+    {
+        for (std::size_t i = 0; i < colors.size(); ++i)
+        {
+            const std::size_t first = edgeStart[i];
+            const EdgePlaneView edges{normalX.data() + first, normalY.data() + first, offset.data() + first, edgeStart[i + 1] - first};
+            float t = Geometry::clipConvexPolygon(ray, edges);
+            if (t >= 0.0F && t < closest.distance)
+            {
+                closest.hit = true;
+                closest.distance = t;
+                closest.color = colors[i];
+            }
+        }
+    }
+};
+
+/**
+ * @brief Detects whether a type provides the primitive kind interface used by PrimitiveSet
+ */
+template <typename Kind, typename = void>
+struct IsPrimitiveKind : std::false_type
+{
+};
+
+template <typename Kind>
+struct IsPrimitiveKind<Kind, std::void_t<decltype(std::declval<const Kind &>().closestHit(std::declval<const Ray &>(),
+                                                                                          std::declval<HitResult &>())),
+                                         decltype(std::declval<Kind &>().clear())>> : std::true_type
+{
+};
+
+/**
+ * @brief Tuple of primitive kinds traced with one fully inlined loop per kind
+ * A primitive kind is registered by listing it in the template arguments. It must provide clear() and a const
+ * closestHit(const Ray &, HitResult &) that only improves on the hit passed in.
+ */
+template <typename... Kinds>
+class PrimitiveSet
+{
+    static_assert((IsPrimitiveKind<Kinds>::value && ...), "PrimitiveSet kinds must provide clear() and closestHit(ray, closest)");
+
+  private:
+    std::tuple<Kinds...> kinds;
+
+  public:
+    /** @brief Access the storage of one primitive kind
+     *  @return Reference to the kind's storage
+     */
+    template <typename Kind>
+    auto get() -> Kind &
+    {
+        return std::get<Kind>(kinds);
+    }
+
+    template <typename Kind>
+    [[nodiscard]] auto get() const -> const Kind &
+    {
+        return std::get<Kind>(kinds);
+    }
+
+    /** @brief Remove all primitives of every kind
+     */
+    auto clear() -> void
+    {
+        (std::get<Kinds>(kinds).clear(), ...);
+    }
+
+    /** @brief Trace a ray against every registered kind, keeping the closest hit
+     *  @param ray The ray to test
+     *  @param closest The closest hit found so far (only distance, color and hit are updated)
+     */
+    auto closestHit(const Ray &ray, HitResult &closest) const -> void
+    {
+        (std::get<Kinds>(kinds).closestHit(ray, closest), ...);
+    }
+};
+
+#endif // HOMEWORK_2_PRIMITIVES_H_
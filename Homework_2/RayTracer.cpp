@@ -13,11 +13,21 @@
 #include "RayTracer.h"
 #include "Scene.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <omp.h>
 #include <thread>
 #include <vector>
 
+#ifdef HW2_PARALLEL_STL_TBB
+#include <execution>
+#include <tbb/global_control.h>
+#endif
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 auto RayTracer::castRaysSingleThreaded(const sf::Vector2f &lightPos, int numRays, const Scene &scene, std::vector<HitResult> &results)
     -> void
@@ -77,3 +87,275 @@ auto RayTracer::castRaysStdThread(const sf::Vector2f &lightPos, int numRays, con
         th.join();
     }
 }
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+auto RayTracer::castRaysParallelSTL(const sf::Vector2f &lightPos, int numRays, const Scene &scene, std::vector<HitResult> &results,
+                                    int numThreads) -> void
+{
+    results.resize(numRays);
+
+    // std::transform needs an input range, so map each ray index to its HitResult
+    std::vector<int> rayIndices(static_cast<std::size_t>(numRays));
+    std::iota(rayIndices.begin(), rayIndices.end(), 0);
+
+    auto traceRay = [&lightPos, numRays, &scene](int i) -> HitResult {
+        auto angle = (RayTracer::TWO_PI * static_cast<float>(i)) / static_cast<float>(numRays);
+        Ray ray;
+        ray.origin = lightPos;
+        ray.direction = {std::cos(angle), std::sin(angle)};
+        return scene.closestIntersection(ray);
+    };
+
+#ifdef HW2_PARALLEL_STL_TBB
+    // Cap the TBB arena so the thread count is comparable with the OpenMP and std::thread modes
+    const tbb::global_control threadLimit(tbb::global_control::max_allowed_parallelism, static_cast<std::size_t>(numThreads));
+    std::transform(std::execution::par_unseq, rayIndices.begin(), rayIndices.end(), results.begin(), traceRay);
+#else
+    // No parallel STL backend available, run the same transform serially
+    static_cast<void>(numThreads);
+    std::transform(rayIndices.begin(), rayIndices.end(), results.begin(), traceRay);
+#endif
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+auto RayTracer::castRaysOpenMPSimd(const sf::Vector2f &lightPos, int numRays, const Scene &scene, ShadedRays &shaded, int numThreads)
+    -> void
+{
+    constexpr float MAX_RAY_DIST = 2000.0F;                                              // Same far point as Scene::closestIntersection
+    constexpr float NO_HIT = std::numeric_limits<float>::max();                          // Distance used while nothing has been hit
+    constexpr float PARALLEL_THRESHOLD = std::numeric_limits<float>::epsilon() * 100.0F; // Same threshold as Geometry
+    const std::uint32_t missColor = sf::Color::White.toInteger();
+
+    shaded.resize(static_cast<std::size_t>(numRays));
+
+    // Raw pointers into the structure-of-arrays scene data keep the hot loops free of bounds checks and exceptions
+    const auto &circles = scene.getPrimitives().get<CirclePrimitives>();
+    const float *circleX = circles.centerX.data();
+    const float *circleY = circles.centerY.data();
+    const float *circleR2 = circles.radiusSquared.data();
+    const std::uint32_t *circleColor = circles.packedColors.data();
+    const std::size_t numCircles = circles.radiusSquared.size();
+
+    const auto &convex = scene.getPrimitives().get<ConvexPolygonPrimitives>();
+    const float *normalX = convex.normalX.data();
+    const float *normalY = convex.normalY.data();
+    const float *offset = convex.offset.data();
+    const std::size_t *edgeStart = convex.edgeStart.data();
+    const std::uint32_t *convexColor = convex.packedColors.data();
+    const std::size_t numConvex = convex.packedColors.size();
+
+    float *hitX = shaded.hitX.data();
+    float *hitY = shaded.hitY.data();
+    std::uint32_t *color = shaded.color.data();
+
+    const float originX = lightPos.x;
+    const float originY = lightPos.y;
+    const float angleStep = RayTracer::TWO_PI / static_cast<float>(numRays);
+    const int numBlocks = (numRays + SIMD_RAY_BLOCK - 1) / SIMD_RAY_BLOCK;
+
+    // Threads take tiles of SIMD_RAY_BLOCK rays; inside a tile every primitive and edge loop is vectorized across the rays, so all
+    // lanes run the same instruction stream with branch-free selects.
+    omp_set_num_threads(numThreads);
+#pragma omp parallel for schedule(static)
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const int first = block * SIMD_RAY_BLOCK;
+        const int lanes = std::min(SIMD_RAY_BLOCK, numRays - first);
+
+        alignas(64) std::array<float, SIMD_RAY_BLOCK> directionXBlock{};
+        alignas(64) std::array<float, SIMD_RAY_BLOCK> directionYBlock{};
+        alignas(64) std::array<float, SIMD_RAY_BLOCK> closestBlock{};
+        alignas(64) std::array<std::uint32_t, SIMD_RAY_BLOCK> colorBlock{};
+        alignas(64) std::array<float, SIMD_RAY_BLOCK> enterBlock{};
+        alignas(64) std::array<float, SIMD_RAY_BLOCK> exitBlock{};
+        alignas(64) std::array<int, SIMD_RAY_BLOCK> outsideBlock{};
+        float *directionX = directionXBlock.data();
+        float *directionY = directionYBlock.data();
+        float *closest = closestBlock.data();
+        std::uint32_t *closestColor = colorBlock.data();
+        float *tEnter = enterBlock.data();
+        float *tExit = exitBlock.data();
+        int *outside = outsideBlock.data();
+
+        // cos/sin only vectorize when the math library exposes SIMD variants (glibc does under -ffast-math)
+#pragma omp simd
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const float angle = angleStep * static_cast<float>(first + lane);
+            directionX[lane] = std::cos(angle);
+            directionY[lane] = std::sin(angle);
+            closest[lane] = NO_HIT;
+            closestColor[lane] = missColor;
+        }
+
+        // Circles: closest positive root of t² + bt + c = 0
+        for (std::size_t c = 0; c < numCircles; ++c)
+        {
+            const float ocX = originX - circleX[c];
+            const float ocY = originY - circleY[c];
+            const float cTerm = ((ocX * ocX) + (ocY * ocY)) - circleR2[c];
+            const std::uint32_t hitColor = circleColor[c];
+#pragma omp simd
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const float b = 2.0F * ((ocX * directionX[lane]) + (ocY * directionY[lane]));
+                const float discriminant = (b * b) - (4.0F * cTerm);
+                const float root = std::sqrt((discriminant > 0.0F) ? discriminant : 0.0F);
+                const float t1 = (-b - root) * 0.5F;
+                const float t2 = (-b + root) * 0.5F;
+                const float t = (t1 > 0.0F) ? t1 : t2;
+                const float candidate = ((discriminant >= 0.0F) & (t > 0.0F)) ? t : NO_HIT;
+                // Selects are computed into locals before any store: GCC's if-conversion gives up on std::min/std::max of array
+                // elements and on selects that interleave with stores, and reports the loop as having control flow
+                const float current = closest[lane];
+                const std::uint32_t currentColor = closestColor[lane];
+                const bool better = candidate < current;
+                const float nextDistance = better ? candidate : current;
+                const std::uint32_t nextColor = better ? hitColor : currentColor;
+                closest[lane] = nextDistance;
+                closestColor[lane] = nextColor;
+            }
+        }
+
+        // Convex polygons: clip every ray of the tile against each edge half-plane
+        for (std::size_t p = 0; p < numConvex; ++p)
+        {
+            const std::uint32_t hitColor = convexColor[p];
+#pragma omp simd
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                tEnter[lane] = -NO_HIT;
+                tExit[lane] = NO_HIT;
+                outside[lane] = 0;
+            }
+
+            for (std::size_t e = edgeStart[p]; e < edgeStart[p + 1]; ++e)
+            {
+                const float edgeX = normalX[e];
+                const float edgeY = normalY[e];
+                const float numerator = offset[e] - ((edgeX * originX) + (edgeY * originY));
+                const int outsideIfParallel = (numerator < 0.0F) ? 1 : 0; // Ray origin is outside this edge
+#pragma omp simd
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    const float denominator = (edgeX * directionX[lane]) + (edgeY * directionY[lane]);
+                    const bool parallel = std::abs(denominator) < PARALLEL_THRESHOLD;
+                    // Nudging instead of selecting the divisor keeps the division unconditional; t is ignored for parallel edges
+                    const float t = numerator / (denominator + (parallel ? 1.0F : 0.0F));
+                    const float enter = tEnter[lane];
+                    const float exit = tExit[lane];
+                    const float nextEnter = ((denominator <= -PARALLEL_THRESHOLD) & (t > enter)) ? t : enter; // Facing edge
+                    const float nextExit = ((denominator >= PARALLEL_THRESHOLD) & (t < exit)) ? t : exit;     // Trailing edge
+                    const int nextOutside = outside[lane] | (parallel ? outsideIfParallel : 0);
+                    tEnter[lane] = nextEnter;
+                    tExit[lane] = nextExit;
+                    outside[lane] = nextOutside;
+                }
+            }
+
+#pragma omp simd
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const float enter = tEnter[lane];
+                const float exit = tExit[lane];
+                const bool hit = (outside[lane] == 0) & (enter <= exit) & (exit >= 0.0F);
+                const float candidate = hit ? ((enter >= 0.0F) ? enter : exit) : NO_HIT;
+                const float current = closest[lane];
+                const std::uint32_t currentColor = closestColor[lane];
+                const bool better = candidate < current;
+                const float nextDistance = better ? candidate : current;
+                const std::uint32_t nextColor = better ? hitColor : currentColor;
+                closest[lane] = nextDistance;
+                closestColor[lane] = nextColor;
+            }
+        }
+
+        // Shade: the end point is the hit (or the far point) and the alpha follows the inverse square law used by getRays
+#pragma omp simd
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            const float distance = (closest[lane] < NO_HIT) ? closest[lane] : MAX_RAY_DIST;
+            hitX[first + lane] = originX + (directionX[lane] * distance);
+            hitY[first + lane] = originY + (directionY[lane] * distance);
+            const float intensity = 10000.0F / (distance * distance);
+            const float brightness = (intensity > 255.0F) ? 255.0F : ((intensity < 50.0F) ? 50.0F : intensity);
+            color[first + lane] = (closestColor[lane] & 0xFFFFFF00U) | static_cast<std::uint32_t>(brightness);
+        }
+    }
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+auto RayTracer::coherenceOrder(const RayBatch &batch, std::vector<std::size_t> &order) -> void
+{
+    order.resize(batch.count);
+    if (batch.count == 0)
+    {
+        return;
+    }
+
+    // Grid over the bounding box of the origins; cells grow when the box is larger than the grid allows
+    auto minX = std::numeric_limits<float>::max();
+    auto minY = std::numeric_limits<float>::max();
+    auto maxX = -std::numeric_limits<float>::max();
+    auto maxY = -std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i < batch.count; ++i)
+    {
+        minX = std::min(minX, batch.origins[i].x);
+        minY = std::min(minY, batch.origins[i].y);
+        maxX = std::max(maxX, batch.origins[i].x);
+        maxY = std::max(maxY, batch.origins[i].y);
+    }
+    float cellSize = std::max({COHERENCE_CELL_SIZE, (maxX - minX) / static_cast<float>(COHERENCE_GRID_CELLS),
+                               (maxY - minY) / static_cast<float>(COHERENCE_GRID_CELLS)});
+    float invCellSize = 1.0F / cellSize;
+    int cellsX = std::min(COHERENCE_GRID_CELLS, static_cast<int>((maxX - minX) * invCellSize) + 1);
+    int cellsY = std::min(COHERENCE_GRID_CELLS, static_cast<int>((maxY - minY) * invCellSize) + 1);
+
+    // Key = origin cell (row-major) followed by the 3-bit direction octant
+    std::vector<std::uint32_t> keys(batch.count);
+    for (std::size_t i = 0; i < batch.count; ++i)
+    {
+        int cellX = std::min(cellsX - 1, static_cast<int>((batch.origins[i].x - minX) * invCellSize));
+        int cellY = std::min(cellsY - 1, static_cast<int>((batch.origins[i].y - minY) * invCellSize));
+        const sf::Vector2f &direction = batch.directions[i];
+        auto octant = static_cast<std::uint32_t>((direction.x < 0.0F ? 4 : 0) | (direction.y < 0.0F ? 2 : 0) |
+                                                 (std::abs(direction.x) < std::abs(direction.y) ? 1 : 0));
+        keys.at(i) = (static_cast<std::uint32_t>((cellY * cellsX) + cellX) << 3U) | octant;
+    }
+
+    // Counting sort, stable and linear in the number of rays
+    std::vector<std::size_t> bucketStart((static_cast<std::size_t>(cellsX * cellsY) << 3U) + 1, 0);
+    for (auto key : keys)
+    {
+        ++bucketStart.at(key + 1);
+    }
+    std::partial_sum(bucketStart.begin(), bucketStart.end(), bucketStart.begin());
+    for (std::size_t i = 0; i < batch.count; ++i)
+    {
+        order.at(bucketStart.at(keys.at(i))++) = i;
+    }
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+auto RayTracer::traceBatch(const RayBatch &batch, const Scene &scene, HitResult *hits, int numThreads, bool sortForCoherence) -> void
+{
+    std::vector<std::size_t> order;
+    if (sortForCoherence)
+    {
+        coherenceOrder(batch, order);
+    }
+
+    const auto count = static_cast<std::ptrdiff_t>(batch.count);
+    omp_set_num_threads(numThreads);
+#pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t i = 0; i < count; ++i)
+    {
+        // Trace in sorted order and scatter the result back to the ray's original slot
+        std::size_t rayIndex = sortForCoherence ? order[static_cast<std::size_t>(i)] : static_cast<std::size_t>(i);
+        Ray ray;
+        ray.origin = batch.origins[rayIndex];
+        ray.direction = batch.directions[rayIndex];
+        float maxDistance = (batch.maxDistances != nullptr) ? batch.maxDistances[rayIndex] : std::numeric_limits<float>::max();
+        hits[rayIndex] = scene.closestIntersection(ray, maxDistance);
+    }
+}
@@ -6,7 +6,8 @@
  *
  *
  * @file Scene.cpp
- * @brief Scene implementation file. Contains the Scene class with methods for creating and managing spheres and walls in the scene.
+ * @brief Scene implementation file. Contains the Scene class with methods for creating and managing spheres, walls and convex polygons
+ * in the scene.
  */
 
 #include "Scene.h"
@@ -20,9 +21,9 @@
 #include <limits>
 #include <random>
 
-Scene::Scene(int windowWidth, int windowHeight, int numSpheres, int numWalls)
-    : windowWidth(windowWidth), windowHeight(windowHeight), numSpheres(numSpheres), numWalls(numWalls), spheres(numSpheres),
-      walls(numWalls), wallRotationCache(numWalls), rng(std::random_device{}())
+Scene::Scene(int windowWidth, int windowHeight, int numSpheres, int numWalls, int numPolygons)
+    : windowWidth(windowWidth), windowHeight(windowHeight), numSpheres(numSpheres), numWalls(numWalls), numPolygons(numPolygons),
+      spheres(numSpheres), walls(numWalls), polygons(numPolygons), rng(std::random_device{}())
 {
     createScene();
 }
@@ -55,6 +56,17 @@ auto Scene::createWall(double width, double height, sf::Color color) -> sf::Rect
     return wall;
 }
 
+auto Scene::createPolygon(const std::vector<sf::Vector2f> &vertices, sf::Color color) -> sf::ConvexShape
+{
+    sf::ConvexShape polygon(vertices.size());
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        polygon.setPoint(i, vertices.at(i));
+    }
+    polygon.setFillColor(color);
+    return polygon;
+}
+
 auto Scene::createSpheres() -> void
 {
     std::uniform_int_distribution<int> radiusDistribution(50, 149); // 50 to 150 (exclusive upper)
@@ -168,9 +180,71 @@ auto Scene::createWalls() -> void
 
         wall.setPosition(pos.x + offsetX, pos.y + offsetY);
 
-        // Add wall to the scene and cache its sin/cos values for fast ray intersection
+        // Add wall to the scene
         walls.at(i) = wall;
-        wallRotationCache.at(i) = {cos_r, sin_r};
+    }
+}
+
+auto Scene::createPolygons() -> void
+{
+    std::uniform_int_distribution<int> sidesDist(3, 8);
+    std::uniform_int_distribution<int> radiusDist(30, 120);
+    std::uniform_real_distribution<float> angleDist(0.0F, 2.0F * static_cast<float>(M_PI));
+    std::uniform_int_distribution<int> colorDist(0, 255);
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(numPolygons); ++i)
+    {
+        int radius = radiusDist(rng);
+
+        // Vertices on a circle sorted by angle always form a convex polygon
+        std::vector<float> angles(static_cast<std::size_t>(sidesDist(rng)));
+        std::generate(angles.begin(), angles.end(), [&]() -> float { return angleDist(rng); });
+        std::sort(angles.begin(), angles.end());
+
+        std::vector<sf::Vector2f> vertices;
+        vertices.reserve(angles.size());
+        for (float angle : angles)
+        {
+            vertices.emplace_back(static_cast<float>(radius) * std::cos(angle), static_cast<float>(radius) * std::sin(angle));
+        }
+
+        sf::Color color(colorDist(rng), colorDist(rng), colorDist(rng));
+        sf::ConvexShape polygon = Scene::createPolygon(vertices, color);
+
+        // Keep the whole circumscribed circle inside the window
+        std::uniform_int_distribution<int> positionXDist(radius, std::max(radius, windowWidth - radius - 1));
+        std::uniform_int_distribution<int> positionYDist(radius, std::max(radius, windowHeight - radius - 1));
+        polygon.setPosition(static_cast<float>(positionXDist(rng)), static_cast<float>(positionYDist(rng)));
+
+        polygons.at(i) = polygon;
+    }
+}
+
+auto Scene::rebuildPrimitives() -> void
+{
+    primitives.clear();
+
+    for (const auto &sphere : spheres)
+    {
+        primitives.get<CirclePrimitives>().add(sphere);
+    }
+
+    auto &convex = primitives.get<ConvexPolygonPrimitives>();
+    for (const auto &wall : walls)
+    {
+        convex.add(Geometry::rectangleCorners(wall), wall.getFillColor());
+    }
+
+    std::vector<sf::Vector2f> vertices;
+    for (const auto &polygon : polygons)
+    {
+        vertices.resize(polygon.getPointCount());
+        const sf::Transform &transform = polygon.getTransform();
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            vertices.at(i) = transform.transformPoint(polygon.getPoint(i));
+        }
+        convex.add(vertices, polygon.getFillColor());
     }
 }
 
@@ -178,6 +252,13 @@ auto Scene::createScene() -> void
 {
     createSpheres();
     createWalls();
+    createPolygons();
+    rebuildPrimitives();
+}
+
+auto Scene::getPrimitives() const -> const ScenePrimitives &
+{
+    return primitives;
 }
 
 auto Scene::draw(sf::RenderWindow &window) -> void
@@ -191,39 +272,36 @@ auto Scene::draw(sf::RenderWindow &window) -> void
     {
         window.draw(wall);
     }
+
+    for (auto &polygon : polygons)
+    {
+        window.draw(polygon);
+    }
 }
 
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 auto Scene::closestIntersection(const Ray &ray) const -> HitResult
+{
+    return closestIntersection(ray, std::numeric_limits<float>::max());
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+auto Scene::closestIntersection(const Ray &ray, float maxDistance) const -> HitResult
 {
     constexpr float MAX_RAY_DIST = 2000.0F;
     HitResult closest;
     closest.hit = false;
-    closest.distance = std::numeric_limits<float>::max();
-    closest.point = ray.origin + (ray.direction * MAX_RAY_DIST); // Default far point if no hit
+    closest.distance = maxDistance; // Kernels only accept hits closer than the current distance
 
-    // Check intersection with all spheres
-    for (const auto &sphere : spheres)
-    {
-        HitResult hit = Geometry::intersectCircle(ray, sphere);
-        if (hit.hit && hit.distance < closest.distance)
-        {
-            closest = hit;
-            closest.color = sphere.getOutlineColor();
-        }
-    }
+    // Each primitive kind runs its own inlined loop; the hit point is only computed once for the winner
+    primitives.closestHit(ray, closest);
 
-    // Check intersection with all walls (using cached sin/cos for efficiency)
-    for (size_t i = 0; i < walls.size(); ++i)
+    if (!closest.hit)
     {
-        const auto &[cos_cached, sin_cached] = wallRotationCache.at(i);
-        HitResult hit = Geometry::intersectRectangle(ray, walls.at(i), cos_cached, sin_cached);
-        if (hit.hit && hit.distance < closest.distance)
-        {
-            closest = hit;
-            closest.color = walls.at(i).getFillColor();
-        }
+        closest.distance = std::numeric_limits<float>::max();
+        closest.point = ray.origin + (ray.direction * std::min(maxDistance, MAX_RAY_DIST)); // Default far point if no hit
+        return closest;
     }
 
+    closest.point = ray.origin + (ray.direction * closest.distance);
     return closest;
 }
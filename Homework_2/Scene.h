@@ -6,19 +6,24 @@
  *
  *
  * @file Scene.h
- * @brief Scene header file. Contains the Scene class with methods for creating and managing spheres and walls in the scene.
+ * @brief Scene header file. Contains the Scene class with methods for creating and managing spheres, walls and convex polygons in the
+ * scene.
  */
 
 #ifndef HOMEWORK_2_SCENE_H_
 #define HOMEWORK_2_SCENE_H_
 
 #include "Geometry.h"
+#include "Primitives.h"
 #include <SFML/Graphics.hpp>
 #include <random>
 #include <vector>
 
+// @brief Primitive kinds traced by the scene. Register a new kind by adding its storage type here.
+using ScenePrimitives = PrimitiveSet<CirclePrimitives, ConvexPolygonPrimitives>;
+
 /** @class Scene
- *  @brief Manages geometric objects (spheres and planes) in a ray tracing scene
+ *  @brief Manages geometric objects (spheres, planes and convex polygons) in a ray tracing scene
  */
 class Scene
 {
@@ -28,10 +33,14 @@ class Scene
     int windowHeight;
     int numSpheres;
     int numWalls;
+    int numPolygons;
     std::vector<sf::CircleShape> spheres;
     std::vector<sf::RectangleShape> walls;
-    std::vector<std::pair<float, float>> wallRotationCache; // pairs of (cos, sin)
-    mutable std::mt19937 rng;                               // Random number generator
+    std::vector<sf::ConvexShape> polygons;
+    mutable std::mt19937 rng; // Random number generator
+
+    // World-space copy of all objects, grouped by primitive kind, used by closestIntersection
+    ScenePrimitives primitives;
 
     /** @brief Create a sphere (circle) with the specified radius
      *  @param radius The radius of the sphere
@@ -61,19 +70,35 @@ class Scene
      */
     static auto createWall(double width, double height, sf::Color color) -> sf::RectangleShape;
 
+    /** @brief Create a colored convex polygon from vertices relative to its position
+     *  @param vertices Polygon vertices in boundary order
+     *  @param color The fill color of the polygon
+     *  @return An sf::ConvexShape representing the polygon
+     */
+    static auto createPolygon(const std::vector<sf::Vector2f> &vertices, sf::Color color) -> sf::ConvexShape;
+
     /** @brief Create spheres in the scene
      */
     auto createSpheres() -> void;
     auto createWalls() -> void;
 
+    /** @brief Create random convex polygons (3 to 8 sides) in the scene
+     */
+    auto createPolygons() -> void;
+
+    /** @brief Rebuild the primitive storage used by closestIntersection from the drawable shapes
+     */
+    auto rebuildPrimitives() -> void;
+
   public:
-    /** @brief Construct a scene with specified number of spheres and walls
+    /** @brief Construct a scene with specified number of spheres, walls and convex polygons
      *  @param windowWidth The width of the window
      *  @param windowHeight The height of the window
      *  @param numSpheres Number of spheres to create
      *  @param numWalls Number of walls to create
+     *  @param numPolygons Number of convex polygons to create (use a large count for polygon-heavy scenes)
      */
-    Scene(int windowWidth, int windowHeight, int numSpheres, int numWalls);
+    Scene(int windowWidth, int windowHeight, int numSpheres, int numWalls, int numPolygons = 0);
 
     /** @brief Draw all scene objects to the render window
      *  @param window The render window to draw to
@@ -86,7 +111,19 @@ class Scene
      */
     [[nodiscard]] auto closestIntersection(const Ray &ray) const -> HitResult;
 
+    /** @brief Find the closest intersection of a ray with scene geometry closer than a maximum distance
+     *  @param ray The ray to test
+     *  @param maxDistance Hits at or beyond this distance are ignored (e.g. the distance to a line-of-sight target)
+     *  @return HitResult containing the closest intersection, or no hit if nothing is intersected within maxDistance
+     */
+    [[nodiscard]] auto closestIntersection(const Ray &ray, float maxDistance) const -> HitResult;
+
     auto createScene() -> void;
+
+    /** @brief Get the structure-of-arrays primitive storage, for kernels that traverse it directly
+     *  @return The scene primitives grouped by kind
+     */
+    [[nodiscard]] auto getPrimitives() const -> const ScenePrimitives &;
 };
 
 #endif // HOMEWORK_2_SCENE_H_